@@ -16,16 +16,29 @@
 
 #include "config.h"
 
+#include "json/utils/dump_query.hpp"
 #include "sdbusplus.hpp"
 
+#ifdef CONTROL_USE_JSON
+#include "json/utils/flight_recorder_file.hpp"
+#endif
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include <CLI/CLI.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 
 using SDBusPlus = phosphor::fan::util::SDBusPlus;
 
@@ -34,6 +47,8 @@ constexpr auto systemdPath = "/org/freedesktop/systemd1";
 constexpr auto systemdService = "org.freedesktop.systemd1";
 constexpr auto phosphorServiceName = "phosphor-fan-control@0.service";
 constexpr auto dumpFile = "/tmp/fan_control_dump.json";
+constexpr auto querySocket = "/run/fan_control_query.sock";
+constexpr auto queryTimeout = std::chrono::seconds{5};
 
 enum
 {
@@ -43,12 +58,7 @@ enum
     METHOD = 3
 };
 
-struct DumpQuery
-{
-    std::string section;
-    std::string name;
-    std::vector<std::string> properties;
-};
+using DumpQuery = phosphor::fan::control::json::DumpQuery;
 
 /**
  * @function extracts fan name from dbus path string (last token where
@@ -236,6 +246,69 @@ std::array<std::string, 6> getStates()
     return ret;
 }
 
+/**
+ * @brief The properties of an object keyed by their interface
+ */
+using ObjectProperties =
+    std::map<std::string,
+             phosphor::fan::util::Properties<bool, uint64_t, double>>;
+
+/**
+ * @function gets all the properties of some of an object's interfaces, with
+ * one call per interface to the service providing them
+ * @param[in] path - the object path
+ * @param[in] ifaces - the interfaces, the first one used to find the service
+ * @return the properties of the interfaces that could be read
+ */
+ObjectProperties getObjectProperties(const std::string& path,
+                                     const std::vector<std::string>& ifaces)
+{
+    auto& bus{SDBusPlus::getBus()};
+    ObjectProperties properties;
+    try
+    {
+        auto service = SDBusPlus::getService(bus, path, ifaces.front());
+        for (const auto& iface : ifaces)
+        {
+            properties[iface] =
+                SDBusPlus::getProperties<bool, uint64_t, double>(
+                    bus, service, path, iface);
+        }
+    }
+    catch (const phosphor::fan::util::DBusError&)
+    {
+        // Whatever couldn't be read is gotten a property at a time
+    }
+    return properties;
+}
+
+/**
+ * @function gets a property from the properties of an object, falling
+ * back to a Get of the property when it isn't in them
+ * @param[in] properties - the properties from getObjectProperties()
+ * @param[in] path - the object path
+ * @param[in] iface - the property's interface
+ * @param[in] property - the property name
+ * @return the property value
+ */
+template <typename T>
+T getFromProperties(const ObjectProperties& properties,
+                    const std::string& path, const std::string& iface,
+                    const std::string& property)
+{
+    auto itIface = properties.find(iface);
+    if (itIface != properties.end())
+    {
+        auto it = itIface->second.find(property);
+        if ((it != itIface->second.end()) &&
+            std::holds_alternative<T>(it->second))
+        {
+            return std::get<T>(it->second);
+        }
+    }
+    return SDBusPlus::getProperty<T>(path, iface, property);
+}
+
 /**
  * @function helper to determine interface type from a given control method
  */
@@ -284,23 +357,31 @@ void status()
     {
         cout << setw(8) << std::left << fan << std::right << setw(13);
 
-        // get the target RPM
+        // get the target RPM, along with the sensor RPM of the first rotor
         property = "Target";
-        cout << SDBusPlus::getProperty<uint64_t>(
-                    pathMap["tach"][fan][0],
-                    interfaces[ifaceTypeFromMethod(method)], property)
+        auto& tachPaths = pathMap["tach"][fan];
+        const auto& targetIface = interfaces[ifaceTypeFromMethod(method)];
+        auto tachProperties = getObjectProperties(
+            tachPaths[0], {interfaces["SensorValue"], targetIface});
+        cout << getFromProperties<uint64_t>(tachProperties, tachPaths[0],
+                                            targetIface, property)
              << setw(19);
 
         // get the sensor RPM
         property = "Value";
 
         std::ostringstream output;
-        int numRotors = pathMap["tach"][fan].size();
+        int numRotors = tachPaths.size();
         // print tach readings for each rotor
-        for (auto& path : pathMap["tach"][fan])
+        for (auto& path : tachPaths)
         {
-            output << SDBusPlus::getProperty<double>(
-                path, interfaces["SensorValue"], property);
+            if (path != tachPaths[0])
+            {
+                tachProperties =
+                    getObjectProperties(path, {interfaces["SensorValue"]});
+            }
+            output << getFromProperties<double>(
+                tachProperties, path, interfaces["SensorValue"], property);
 
             // dont print slash on last rotor
             if (--numRotors)
@@ -579,7 +660,6 @@ void dumpFanControl()
  */
 void queryDumpFile(const DumpQuery& dq)
 {
-    nlohmann::json output;
     std::ifstream file{dumpFile};
 
     if (!file.good())
@@ -598,70 +678,218 @@ void queryDumpFile(const DumpQuery& dq)
         return;
     }
 
-    const auto& section = dumpData.at(dq.section);
+    auto output = dq.filter(dumpData.at(dq.section));
+    if (!output.empty())
+    {
+        std::cout << std::setw(4) << output << "\n";
+    }
+}
 
-    if (section.is_array())
+/**
+ * @function Query fan control for a dump section over its query socket
+ * @param[in] dq - The query
+ * @return The response, or std::nullopt when fan control can't be reached
+ * or doesn't respond in time, i.e. when it's stopped or busy
+ */
+std::optional<nlohmann::json> queryFanControl(const DumpQuery& dq)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, querySocket, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+
+    // Also bounds the connect, which waits when the backlog is full
+    timeval timeout{};
+    timeout.tv_sec = queryTimeout.count();
+    if ((setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) !=
+         0) ||
+        (setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) !=
+         0) ||
+        (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0))
     {
-        for (const auto& entry : section)
+        close(fd);
+        return std::nullopt;
+    }
+
+    auto request = dq.toJson().dump() + "\n";
+    size_t written = 0;
+    while (written < request.size())
+    {
+        auto size = send(fd, request.data() + written,
+                         request.size() - written, MSG_NOSIGNAL);
+        if (size < 0)
         {
-            if (!entry.is_string() || dq.name.empty() ||
-                (entry.get<std::string>().find(dq.name) != std::string::npos))
-            {
-                output[dq.section].push_back(entry);
-            }
+            close(fd);
+            return std::nullopt;
         }
-        std::cout << std::setw(4) << output << "\n";
+        written += size;
+    }
+
+    std::string response;
+    char buf[4096];
+    ssize_t size;
+    while ((size = recv(fd, buf, sizeof(buf), 0)) > 0)
+    {
+        response.append(buf, size);
+    }
+    close(fd);
+    if (size < 0)
+    {
+        return std::nullopt;
+    }
+
+    // A response cut short, like by fan control stopping, isn't valid JSON
+    auto json = nlohmann::json::parse(response, nullptr, false);
+    if (json.is_discarded())
+    {
+        return std::nullopt;
+    }
+    return json;
+}
+
+/**
+ * @function Query items of the dump, from fan control itself when it's
+ * running, otherwise from the dump file
+ * @param[in] dq - The query
+ */
+void queryDump(const DumpQuery& dq)
+{
+    auto response = queryFanControl(dq);
+    if (!response)
+    {
+        queryDumpFile(dq);
         return;
     }
 
-    for (const auto& [key1, values1] : section.items())
+    if (response->contains("error"))
     {
-        if (dq.name.empty() || (key1.find(dq.name) != std::string::npos))
+        std::cerr << "Error: " << response->at("error").get<std::string>()
+                  << "\n";
+        return;
+    }
+
+    const auto& output = response->at("result");
+    if (!output.empty())
+    {
+        std::cout << std::setw(4) << output << "\n";
+    }
+}
+
+/**
+ * @function Print how long fan control spent running each action and
+ * trigger, from fan control itself when it's running, otherwise from the
+ * dump file, with the most expensive first
+ * @param[in] name - Optional action or trigger name (or substring)
+ */
+void printProfile(const std::string& name)
+{
+    using std::cout;
+    using std::setw;
+
+    // Match the entry names here, as the query would match the categories
+    DumpQuery dq;
+    dq.section = "profile";
+    nlohmann::json profile;
+
+    auto response = queryFanControl(dq);
+    if (response)
+    {
+        if (response->contains("error"))
         {
-            // If no properties specified, print the whole JSON value
-            if (dq.properties.empty())
-            {
-                output[key1] = values1;
-                continue;
-            }
+            std::cerr << "Error: " << response->at("error").get<std::string>()
+                      << "\n";
+            return;
+        }
+        profile = response->at("result");
+    }
+    else
+    {
+        std::ifstream file{dumpFile};
+        if (!file.good())
+        {
+            std::cerr << "Unable to query fan control or open dump file, "
+                         "please run 'fanctl dump'.\n";
+            return;
+        }
+        profile = nlohmann::json::parse(file).value("profile",
+                                                    nlohmann::json::object());
+    }
 
-            // Look for properties both one and two levels down.
-            // Future improvement: Use recursion.
-            for (const auto& [key2, values2] : values1.items())
+    struct Row
+    {
+        uint64_t total;
+        uint64_t count;
+        uint64_t avg;
+        uint64_t max;
+        std::string category;
+        std::string name;
+    };
+    std::vector<Row> rows;
+    dq.name = name;
+    for (const auto& [category, entries] : profile.items())
+    {
+        for (const auto& [entry, stats] : entries.items())
+        {
+            if (dq.matchesName(entry))
             {
-                for (const auto& prop : dq.properties)
-                {
-                    if (prop == key2)
-                    {
-                        output[key1][prop] = values2;
-                    }
-                }
-
-                for (const auto& [key3, values3] : values2.items())
-                {
-                    for (const auto& prop : dq.properties)
-                    {
-                        if (prop == key3)
-                        {
-                            output[key1][prop] = values3;
-                        }
-                    }
-                }
+                rows.push_back({stats["total_us"].get<uint64_t>(),
+                                stats["count"].get<uint64_t>(),
+                                stats["avg_us"].get<uint64_t>(),
+                                stats["max_us"].get<uint64_t>(), category,
+                                entry});
             }
         }
     }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.total > b.total;
+    });
+
+    cout << std::left << setw(14) << "TOTAL(us)" << setw(10) << "COUNT"
+         << setw(10) << "AVG(us)" << setw(10) << "MAX(us)" << setw(10)
+         << "TYPE"
+         << "NAME\n";
+    cout << std::string(78, '=') << "\n";
+    for (const auto& row : rows)
+    {
+        cout << setw(14) << row.total << setw(10) << row.count << setw(10)
+             << row.avg << setw(10) << row.max << setw(10) << row.category
+             << row.name << "\n";
+    }
+}
 
-    if (!output.empty())
+#ifdef CONTROL_USE_JSON
+/**
+ * @function Print the flight recorder fan control keeps in a file
+ * @param[in] path - Path of the file
+ */
+void printFlightRecorderFile(const std::string& path)
+{
+    using phosphor::fan::control::json::FlightRecorderFile;
+
+    if (path.empty())
     {
-        std::cout << std::setw(4) << output << "\n";
+        std::cerr << "No flight recorder file configured, please give one "
+                     "with '-f'.\n";
+        return;
+    }
+
+    for (const auto& line : FlightRecorderFile::decode(path))
+    {
+        std::cout << line << std::endl;
     }
 }
+#endif
 
 /**
  * @function setup the CLI object to accept all options
  */
 void initCLI(CLI::App& app, uint64_t& target, std::vector<std::string>& fanList,
-             DumpQuery& dq)
+             DumpQuery& dq, std::string& recorderFile)
 {
     app.set_help_flag("-h,--help", "Print this help page and exit.");
 
@@ -732,6 +960,23 @@ void initCLI(CLI::App& app, uint64_t& target, std::vector<std::string>& fanList,
                              "Optional dump file entry name (or substring)");
     cmdDumpQuery->add_option("-p, --properties", dq.properties,
                              "Optional list of dump file property names");
+
+    // Profile
+    strHelp = "Print how long fan control spent running each action and "
+              "trigger, most expensive first";
+    auto cmdProfile = commands->add_subcommand("profile", strHelp);
+    cmdProfile->set_help_flag("-h, --help", strHelp);
+    cmdProfile->add_option("-n, --name", dq.name,
+                           "Optional action or trigger name (or substring)");
+
+    // Flight recorder file
+    strHelp = "Print the flight recorder fan control keeps in a file, even "
+              "after fan control crashed";
+    auto cmdRecorder = commands->add_subcommand("flight_recorder", strHelp);
+    cmdRecorder->set_help_flag("-h, --help", strHelp);
+    cmdRecorder->add_option(
+        "-f, --file", recorderFile,
+        "Optional flight recorder file (default: the configured file)");
 #endif
 }
 
@@ -744,6 +989,11 @@ int main(int argc, char* argv[])
     uint64_t target{0U};
     std::vector<std::string> fanList;
     DumpQuery dq;
+#ifdef CONTROL_USE_JSON
+    std::string recorderFile{CONTROL_FLIGHT_RECORDER_FILE};
+#else
+    std::string recorderFile;
+#endif
 
     try
     {
@@ -753,7 +1003,7 @@ int main(int argc, char* argv[])
                      "https://github.com/openbmc/phosphor-fan-presence/tree/"
                      "master/docs/control/fanctl"};
 
-        initCLI(app, target, fanList, dq);
+        initCLI(app, target, fanList, dq, recorderFile);
 
         CLI11_PARSE(app, argc, argv);
 
@@ -792,7 +1042,15 @@ int main(int argc, char* argv[])
 #ifdef CONTROL_USE_JSON
         else if (app.got_subcommand("query_dump"))
         {
-            queryDumpFile(dq);
+            queryDump(dq);
+        }
+        else if (app.got_subcommand("profile"))
+        {
+            printProfile(dq.name);
+        }
+        else if (app.got_subcommand("flight_recorder"))
+        {
+            printFlightRecorderFile(recorderFile);
         }
 #endif
     }
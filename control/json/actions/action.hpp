@@ -16,6 +16,7 @@
 #pragma once
 
 #include "../utils/flight_recorder.hpp"
+#include "../utils/profiler.hpp"
 #include "../zone.hpp"
 #include "config_base.hpp"
 #include "group.hpp"
@@ -31,6 +32,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 
 namespace phosphor::fan::control::json
 {
@@ -106,7 +108,11 @@ class ActionBase : public ConfigBase
     ActionBase(ActionBase&&) = delete;
     ActionBase& operator=(const ActionBase&) = delete;
     ActionBase& operator=(ActionBase&&) = delete;
-    virtual ~ActionBase() = default;
+    virtual ~ActionBase()
+    {
+        // Actions are replaced with new unique names on a config reload
+        Profiler::instance().release(_profilerID);
+    }
 
     /**
      * @brief Base action object
@@ -121,7 +127,8 @@ class ActionBase : public ConfigBase
      */
     ActionBase(const json& jsonObj, const std::vector<Group>& groups) :
         ConfigBase(jsonObj), _groups(groups),
-        _uniqueName(getName() + "-" + std::to_string(_actionCount++))
+        _uniqueName(getName() + "-" + std::to_string(_actionCount++)),
+        _profilerID(Profiler::instance().getID(Profiler::actions, _uniqueName))
     {}
 
     /**
@@ -179,10 +186,12 @@ class ActionBase : public ConfigBase
      * @brief Trigger the action to run against all of its zones
      *
      * This is the function used by triggers to run the actions against all the
-     * zones that were configured for the action to run against.
+     * zones that were configured for the action to run against. Each run is
+     * recorded in the profiler under the action's unique name.
      */
     void run()
     {
+        Profiler::Scope profile{_profilerID};
         std::for_each(_zones.begin(), _zones.end(),
                       [this](Zone& zone) { this->run(zone); });
     }
@@ -206,7 +215,25 @@ class ActionBase : public ConfigBase
      */
     void record(const std::string& message) const
     {
-        FlightRecorder::instance().log(getUniqueName(), message);
+        record("{}", message);
+    }
+
+    /**
+     * @brief Logs a message to the flight recorder using
+     *        the unique name of the action.
+     *
+     * @param[in] format - The fmt format string literal of the message
+     * @param[in] args - The arguments of the message
+     */
+    template <typename... Args>
+    void record(const char* format, Args&&... args) const
+    {
+        auto& recorder = FlightRecorder::instance();
+        if (!_recorderID)
+        {
+            _recorderID = recorder.getID(getUniqueName());
+        }
+        recorder.log(*_recorderID, format, std::forward<Args>(args)...);
     }
 
     /* Groups configured on the action */
@@ -220,6 +247,12 @@ class ActionBase : public ConfigBase
      * It's just the name plus _actionCount at the time of action creation. */
     const std::string _uniqueName;
 
+    /* Flight recorder ID of the action, interned when it first logs */
+    mutable std::optional<FlightRecorder::ID> _recorderID;
+
+    /* Profiler ID of the action */
+    const Profiler::ID _profilerID;
+
     /* Running count of all actions */
     static inline size_t _actionCount = 0;
 };
@@ -37,12 +37,11 @@ void CountStateFloor::run(Zone& zone)
     size_t numAtState = 0;
     for (const auto& group : _groups)
     {
-        for (const auto& member : group.getMembers())
+        for (const auto slot : group.getSlots())
         {
             try
             {
-                if (Manager::getObjValueVariant(member, group.getInterface(),
-                                                group.getProperty()) == _state)
+                if (Manager::getObjValueVariant(slot) == _state)
                 {
                     numAtState++;
                 }
@@ -27,6 +27,9 @@ GetManagedObjects::GetManagedObjects(const json& jsonObj,
                                      const std::vector<Group>& groups) :
     ActionBase(jsonObj, groups)
 {
+    // Keeping the objects current with signals is optional
+    _trackObjects = jsonObj.contains("track_objects") &&
+                    jsonObj["track_objects"].get<bool>();
     setActions(jsonObj);
 }
 
@@ -34,6 +37,12 @@ void GetManagedObjects::run(Zone& zone)
 {
     std::set<std::string> services;
 
+    // Perform the actions once the refreshed values are received
+    auto load = zone.getManager()->startLoad([this]() {
+        std::for_each(_actions.begin(), _actions.end(),
+                      [](auto& action) { action->run(); });
+    });
+
     // Call Manager::addObjects to refresh the values of the group members.
     // If there is an ObjectManager interface that handles them, then
     // the code can combine all members in the same service down to one call.
@@ -72,14 +81,13 @@ void GetManagedObjects::run(Zone& zone)
                 }
 
                 zone.getManager()->addObjects(member, group.getInterface(),
-                                              group.getProperty());
+                                              group.getProperty(), load,
+                                              _trackObjects);
             }
         }
     }
 
-    // Perform the actions
-    std::for_each(_actions.begin(), _actions.end(),
-                  [](auto& action) { action->run(); });
+    zone.getManager()->endLoad(load);
 }
 
 void GetManagedObjects::setZones(
@@ -31,17 +31,24 @@ using json = nlohmann::json;
  *
  * This action adds the members of its groups to the object cache
  * by using Manager::addObjects() which calls the GetManagedObjects
- * D-Bus method to find and add the results.  When that is done,
- * it then runs any actions listed in the JSON.
+ * D-Bus method to find and add the results.  Once the results are
+ * received, it then runs any actions listed in the JSON.
  *
  * This allows an action to run with the latest values in the cache
  * without having to subscribe to propertiesChanged for them all.
  *
+ * With the optional "track_objects" set to true, the managed objects are
+ * only gotten the first time and are then kept current with the service's
+ * InterfacesAdded, InterfacesRemoved, and PropertiesChanged signals. They
+ * are only gotten again when they need a resync, like after the service's
+ * owner changed.
+ *
  * An example config is:
  *
  *    "actions": [
  *      {
  *        "name": "get_managed_objects",
+ *        "track_objects": true,
  *        "groups": [
  *          {
  *            "name": "the_temps",
@@ -112,6 +119,9 @@ class GetManagedObjects :
 
     /* List of actions to be called when this action runs */
     std::vector<std::unique_ptr<ActionBase>> _actions;
+
+    /* If the managed objects are kept current with signals */
+    bool _trackObjects = false;
 };
 
 } // namespace phosphor::fan::control::json
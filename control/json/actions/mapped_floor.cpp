@@ -202,12 +202,11 @@ std::optional<PropertyVariantType>
     std::optional<PropertyVariantType> max;
     bool checked = false;
 
-    for (const auto& member : group.getMembers())
+    for (const auto slot : group.getSlots())
     {
         try
         {
-            auto value = Manager::getObjValueVariant(
-                member, group.getInterface(), group.getProperty());
+            const auto& value = Manager::getObjValueVariant(slot);
 
             // Only allow a group to have multiple members if it's numeric.
             // Unlike std::is_arithmetic, bools are not considered numeric
@@ -57,12 +57,14 @@ void NetTargetDecrease::run(Zone& zone)
     auto netDelta = zone.getDecDelta();
     for (const auto& group : _groups)
     {
-        for (const auto& member : group.getMembers())
+        const auto& members = group.getMembers();
+        const auto& slots = group.getSlots();
+        for (size_t i = 0; i < members.size(); i++)
         {
+            const auto& member = members[i];
             try
             {
-                auto value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
+                const auto& value = Manager::getObjValueVariant(slots[i]);
                 if (std::holds_alternative<int64_t>(value) ||
                     std::holds_alternative<double>(value))
                 {
@@ -59,80 +59,77 @@ void NetTargetIncrease::run(Zone& zone)
     for (const auto& group : _groups)
     {
         const auto& members = group.getMembers();
-        std::for_each(
-            members.begin(), members.end(),
-            [this, &zone, &group, &netDelta](const auto& member) {
-                try
+        const auto& slots = group.getSlots();
+        for (size_t i = 0; i < members.size(); i++)
+        {
+            const auto& member = members[i];
+            try
+            {
+                const auto& value = Manager::getObjValueVariant(slots[i]);
+                if (std::holds_alternative<int64_t>(value) ||
+                    std::holds_alternative<double>(value))
                 {
-                    auto value = Manager::getObjValueVariant(
-                        member, group.getInterface(), group.getProperty());
-                    if (std::holds_alternative<int64_t>(value) ||
-                        std::holds_alternative<double>(value))
+                    // Where a group of int/doubles are greater than or equal to
+                    // the state(some value) provided, request an increase of
+                    // the configured delta times the difference between the
+                    // group member's value and configured state value.
+                    if (value >= _state)
                     {
-                        // Where a group of int/doubles are greater than or
-                        // equal to the state(some value) provided, request an
-                        // increase of the configured delta times the difference
-                        // between the group member's value and configured state
-                        // value.
-                        if (value >= _state)
+                        uint64_t incDelta = 0;
+                        if (auto dblPtr = std::get_if<double>(&value))
                         {
-                            uint64_t incDelta = 0;
-                            if (auto dblPtr = std::get_if<double>(&value))
-                            {
-                                incDelta = static_cast<uint64_t>(
-                                    (*dblPtr - std::get<double>(_state)) *
-                                    _delta);
-                            }
-                            else
-                            {
-                                // Increase by at least a single delta
-                                // to attempt bringing under provided 'state'
-                                auto deltaFactor =
-                                    std::max((std::get<int64_t>(value) -
-                                              std::get<int64_t>(_state)),
-                                             1ll);
-                                incDelta =
-                                    static_cast<uint64_t>(deltaFactor * _delta);
-                            }
-                            netDelta = std::max(netDelta, incDelta);
+                            incDelta = static_cast<uint64_t>(
+                                (*dblPtr - std::get<double>(_state)) * _delta);
                         }
-                    }
-                    else if (std::holds_alternative<bool>(value))
-                    {
-                        // Where a group of booleans equal the state(`true` or
-                        // `false`) provided, request an increase of the
-                        // configured delta
-                        if (_state == value)
+                        else
                         {
-                            netDelta = std::max(netDelta, _delta);
+                            // Increase by at least a single delta to attempt
+                            // bringing under provided 'state'
+                            auto deltaFactor =
+                                std::max((std::get<int64_t>(value) -
+                                          std::get<int64_t>(_state)),
+                                         1ll);
+                            incDelta =
+                                static_cast<uint64_t>(deltaFactor * _delta);
                         }
+                        netDelta = std::max(netDelta, incDelta);
                     }
-                    else if (std::holds_alternative<std::string>(value))
+                }
+                else if (std::holds_alternative<bool>(value))
+                {
+                    // Where a group of booleans equal the state(`true` or
+                    // `false`) provided, request an increase of the configured
+                    // delta
+                    if (_state == value)
                     {
-                        // Where a group of strings equal the state(some string)
-                        // provided, request an increase of the configured delta
-                        if (_state == value)
-                        {
-                            netDelta = std::max(netDelta, _delta);
-                        }
+                        netDelta = std::max(netDelta, _delta);
                     }
-                    else
+                }
+                else if (std::holds_alternative<std::string>(value))
+                {
+                    // Where a group of strings equal the state(some string)
+                    // provided, request an increase of the configured delta
+                    if (_state == value)
                     {
-                        // Unsupported group member type for this action
-                        log<level::ERR>(
-                            fmt::format(
-                                "Action {}: Unsupported group member type "
-                                "given. [object = {} : {} : {}]",
-                                ActionBase::getName(), member,
-                                group.getInterface(), group.getProperty())
-                                .c_str());
+                        netDelta = std::max(netDelta, _delta);
                     }
                 }
-                catch (const std::out_of_range& oore)
+                else
                 {
-                    // Property value not found, netDelta unchanged
+                    // Unsupported group member type for this action
+                    log<level::ERR>(
+                        fmt::format("Action {}: Unsupported group member type "
+                                    "given. [object = {} : {} : {}]",
+                                    ActionBase::getName(), member,
+                                    group.getInterface(), group.getProperty())
+                            .c_str());
                 }
-            });
+            }
+            catch (const std::out_of_range& oore)
+            {
+                // Property value not found, netDelta unchanged
+            }
+        }
     }
     // Request increase to target
     zone.requestIncrease(netDelta);
@@ -45,12 +45,11 @@ void OverrideFanTarget::run(Zone& zone)
 
     for (const auto& group : _groups)
     {
-        for (const auto& member : group.getMembers())
+        for (const auto slot : group.getSlots())
         {
             try
             {
-                if (Manager::getObjValueVariant(member, group.getInterface(),
-                                                group.getProperty()) == _state)
+                if (Manager::getObjValueVariant(slot) == _state)
                 {
                     numAtState++;
 
@@ -82,8 +81,8 @@ void OverrideFanTarget::lockFans(Zone& zone)
 {
     if (!_locked)
     {
-        record("Adding fan target lock of " + std::to_string(_target) +
-               " on zone " + zone.getName());
+        record("Adding fan target lock of {} on zone {}", _target,
+               zone.getName());
 
         for (auto& fan : _fans)
         {
@@ -96,8 +95,7 @@ void OverrideFanTarget::lockFans(Zone& zone)
 
 void OverrideFanTarget::unlockFans(Zone& zone)
 {
-    record("Un-locking fan target " + std::to_string(_target) + " on zone " +
-           zone.getName());
+    record("Un-locking fan target {} on zone {}", _target, zone.getName());
 
     // unlock all fans in this instance
     for (auto& fan : _fans)
@@ -38,6 +38,14 @@ PCIeCardFloors::PCIeCardFloors(const json& jsonObj,
     ActionBase(jsonObj, groups)
 {
     loadCardJSON(jsonObj);
+
+    // The cards' IDs are read from the cache, not from a group's members
+    auto& cache = PropertyCache::instance();
+    for (const auto* prop : {deviceIDProp, vendorIDProp, subsystemIDProp,
+                             subsystemVendorIDProp})
+    {
+        cache.addInterest(pcieDeviceIface, prop);
+    }
 }
 
 void PCIeCardFloors::run(Zone& zone)
@@ -73,14 +81,16 @@ void PCIeCardFloors::execute(Zone& zone)
             continue;
         }
 
-        for (const auto& slotPath : group.getMembers())
+        const auto& members = group.getMembers();
+        const auto& slots = group.getSlots();
+        for (size_t i = 0; i < members.size(); i++)
         {
+            const auto& slotPath = members[i];
             PropertyVariantType powerState;
 
             try
             {
-                powerState = Manager::getObjValueVariant(
-                    slotPath, group.getInterface(), group.getProperty());
+                powerState = Manager::getObjValueVariant(slots[i]);
             }
             catch (const std::out_of_range& oore)
             {
@@ -137,14 +147,13 @@ void PCIeCardFloors::execute(Zone& zone)
     {
         if (origIndex != floorIndex)
         {
-            record(fmt::format("Setting {} parameter to {}", floorIndexParam,
-                               floorIndex));
+            record("Setting {} parameter to {}", floorIndexParam, floorIndex);
             Manager::setParameter(floorIndexParam, floorIndex);
         }
     }
     else if (origIndexVariant)
     {
-        record(fmt::format("Removing parameter {}", floorIndexParam));
+        record("Removing parameter {}", floorIndexParam);
         Manager::setParameter(floorIndexParam, std::nullopt);
     }
 }
@@ -44,12 +44,14 @@ void RequestTargetBase::run(Zone& zone)
     uint64_t base = 0;
     for (const auto& group : _groups)
     {
-        for (const auto& member : group.getMembers())
+        const auto& members = group.getMembers();
+        const auto& slots = group.getSlots();
+        for (size_t i = 0; i < members.size(); i++)
         {
+            const auto& member = members[i];
             try
             {
-                auto value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
+                const auto& value = Manager::getObjValueVariant(slots[i]);
                 if (auto intPtr = std::get_if<int64_t>(&value))
                 {
                     // Throw out any negative values as those are not valid
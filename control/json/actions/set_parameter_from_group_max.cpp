@@ -43,13 +43,12 @@ void SetParameterFromGroupMax::run(Zone& zone)
     for (const auto& group : _groups)
     {
         const auto& members = group.getMembers();
-        for (const auto& member : members)
+        for (const auto slot : group.getSlots())
         {
             PropertyVariantType value;
             try
             {
-                value = Manager::getObjValueVariant(
-                    member, group.getInterface(), group.getProperty());
+                value = Manager::getObjValueVariant(slot);
             }
             catch (const std::out_of_range&)
             {
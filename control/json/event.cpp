@@ -91,6 +91,13 @@ void Event::powerOff()
     }
 }
 
+bool Event::hasTrigger(const std::string& type) const
+{
+    return std::any_of(
+        _triggers.begin(), _triggers.end(),
+        [&type](const auto& trigger) { return std::get<0>(trigger) == type; });
+}
+
 std::map<configKey, std::unique_ptr<Group>>&
     Event::getAllGroups(bool loadGroups)
 {
@@ -112,12 +119,17 @@ void Event::configGroup(Group& group, const json& jsonObj)
         throw std::runtime_error("Missing required group attribute");
     }
 
-    // Get the group members' interface
+    // Get the group members' interface and property name, which are needed
+    // for the group to have a property cache slot for each member
     auto intf = jsonObj["interface"].get<std::string>();
-    group.setInterface(intf);
-
-    // Get the group members' property name
     auto prop = jsonObj["property"]["name"].get<std::string>();
+    if (intf.empty() || prop.empty())
+    {
+        log<level::ERR>("Empty group interface or property name",
+                        entry("JSON=%s", jsonObj.dump().c_str()));
+        throw std::runtime_error("Empty group interface or property name");
+    }
+    group.setInterface(intf);
     group.setProperty(prop);
 
     // Get the group members' data type
@@ -83,6 +83,23 @@ class Event : public ConfigBase
      */
     void powerOn();
 
+    /**
+     * @brief Get the event's groups
+     *
+     * @return The groups associated with the event
+     */
+    inline const auto& getGroups() const
+    {
+        return _groups;
+    }
+
+    /**
+     * @brief Returns if the event has a trigger of the given type
+     *
+     * @param[in] type - The trigger type, i.e. "init"
+     */
+    bool hasTrigger(const std::string& type) const;
+
     /**
      * @brief Call any power off triggers
      */
@@ -23,6 +23,10 @@
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <variant>
+
 namespace phosphor::fan::control::json
 {
 
@@ -36,6 +40,7 @@ Fan::Fan(const json& jsonObj) :
     ConfigBase(jsonObj), _bus(util::SDBusPlus::getBus())
 {
     setInterface(jsonObj);
+    setHwmon(jsonObj);
     setSensors(jsonObj);
     setZone(jsonObj);
 }
@@ -64,6 +69,21 @@ void Fan::setSensors(const json& jsonObj)
     for (const auto& sensor : jsonObj["sensors"])
     {
         path = FAN_SENSOR_PATH + sensor.get<std::string>();
+        if (_hwmon)
+        {
+            auto attr = _hwmonAttrs.find(path);
+            if (attr == _hwmonAttrs.end())
+            {
+                log<level::ERR>(
+                    "Missing required fan sensor hwmon attribute",
+                    entry("JSON=%s", jsonObj.dump().c_str()));
+                throw std::runtime_error(
+                    "Missing required fan sensor hwmon attribute");
+            }
+            // No service is used for writing the sensor's target
+            _sensors[path] = "";
+            continue;
+        }
         auto service = util::SDBusPlus::getService(_bus, path, _interface);
         _sensors[path] = service;
     }
@@ -71,8 +91,39 @@ void Fan::setSensors(const json& jsonObj)
     // so only need to read target property from one of them
     if (!path.empty())
     {
-        _target = util::SDBusPlus::getProperty<uint64_t>(
-            _bus, _sensors.at(path), path, _interface, FAN_TARGET_PROPERTY);
+        if (_hwmon)
+        {
+            _target = _hwmon->read(_hwmonAttrs.at(path));
+        }
+        else
+        {
+            _target = util::SDBusPlus::getProperty<uint64_t>(
+                _bus, _sensors.at(path), path, _interface,
+                FAN_TARGET_PROPERTY);
+        }
+    }
+}
+
+void Fan::setHwmon(const json& jsonObj)
+{
+    if (!jsonObj.contains("hwmon"))
+    {
+        return;
+    }
+
+    const auto& hwmon = jsonObj["hwmon"];
+    if (!hwmon.contains("path") || !hwmon.contains("attributes"))
+    {
+        log<level::ERR>("Missing required fan hwmon parameters",
+                        entry("JSON=%s", jsonObj.dump().c_str()),
+                        entry("REQUIRED_PARAMETERS=%s", "{path, attributes}"));
+        throw std::runtime_error("Missing required fan hwmon parameters");
+    }
+    _hwmon = std::make_unique<util::HwmonSysfs>(
+        hwmon["path"].get<std::string>());
+    for (const auto& [sensor, attr] : hwmon["attributes"].items())
+    {
+        _hwmonAttrs[FAN_SENSOR_PATH + sensor] = attr.get<std::string>();
     }
 }
 
@@ -87,32 +138,167 @@ void Fan::setZone(const json& jsonObj)
     _zone = jsonObj["zone"].get<std::string>();
 }
 
+void TargetBatch::fail(std::string&& error)
+{
+    _errors.emplace_back(std::move(error));
+}
+
+void TargetBatch::complete()
+{
+    if (--_pending == 0)
+    {
+        for (const auto& error : _errors)
+        {
+            log<level::ERR>(error.c_str());
+        }
+        _errors.clear();
+    }
+}
+
 void Fan::setTarget(uint64_t target)
 {
-    if ((_target == target) || !_lockedTargets.empty())
+    auto batch = std::make_shared<TargetBatch>();
+    setTarget(target, batch);
+    batch->complete();
+}
+
+void Fan::setTarget(uint64_t target, const std::shared_ptr<TargetBatch>& batch)
+{
+    if ((_pendingTarget.value_or(_target) == target) ||
+        !_lockedTargets.empty())
+    {
+        return;
+    }
+
+    if (_hwmon)
     {
+        // Sysfs writes complete immediately, nothing to wait on
+        writeHwmonTarget(target, *batch);
         return;
     }
 
+    auto sent = _writes.size();
     for (const auto& sensor : _sensors)
     {
-        auto value = target;
+        auto write = std::make_unique<TargetWrite>();
+        write->fan = this;
+        write->target = target;
+        write->path = sensor.first;
+        write->service = sensor.second;
+        write->failed = false;
+        write->batch = batch;
+
+        sd_bus_slot* slot = nullptr;
         try
         {
-            util::SDBusPlus::setProperty<uint64_t>(
-                _bus, sensor.second, sensor.first, _interface,
-                FAN_TARGET_PROPERTY, std::move(value));
+            auto msg = _bus.new_method_call(
+                sensor.second.c_str(), sensor.first.c_str(),
+                "org.freedesktop.DBus.Properties", "Set");
+            msg.append(_interface, FAN_TARGET_PROPERTY,
+                       std::variant<uint64_t>(target));
+            auto r = sd_bus_call_async(_bus.get(), &slot, msg.get(),
+                                       &Fan::targetWritten, write.get(), 0);
+            if (r < 0)
+            {
+                throw std::runtime_error(std::strerror(-r));
+            }
         }
-        catch (const sdbusplus::exception::exception&)
+        catch (const std::exception& e)
         {
-            throw util::DBusPropertyError{
-                fmt::format("Failed to set target for fan {}", _name).c_str(),
-                sensor.second, sensor.first, _interface, FAN_TARGET_PROPERTY};
+            batch->fail(fmt::format(
+                "Failed to send target {} for fan {} to {} {}: {}", target,
+                _name, sensor.second, sensor.first, e.what()));
+
+            // The target is not committed when any sensor fails to be
+            // written, so the writes already sent of it don't commit it
+            std::for_each(_writes.begin() + sent, _writes.end(),
+                          [](auto& write) { write->failed = true; });
+            return;
+        }
+        write->slot.reset(slot);
+        batch->add();
+        _writes.emplace_back(std::move(write));
+    }
+    _pendingTarget = target;
+}
+
+void Fan::writeHwmonTarget(uint64_t target, TargetBatch& batch)
+{
+    for (const auto& sensor : _sensors)
+    {
+        try
+        {
+            _hwmon->write(_hwmonAttrs.at(sensor.first), target);
+        }
+        catch (const std::exception& e)
+        {
+            // The target is not committed so the next request retries it
+            batch.fail(fmt::format("Failed to write target {} for fan {} to "
+                                   "{}: {}",
+                                   target, _name, sensor.first, e.what()));
+            return;
         }
     }
     _target = target;
 }
 
+int Fan::targetWritten(sd_bus_message* msg, void* data, sd_bus_error*)
+{
+    auto& fan = *static_cast<TargetWrite*>(data)->fan;
+    auto it = std::find_if(
+        fan._writes.begin(), fan._writes.end(),
+        [data](const auto& write) { return write.get() == data; });
+    if (it == fan._writes.end())
+    {
+        return 0;
+    }
+    // Take the write out of the writes in flight, releasing it when done
+    auto write = std::move(*it);
+    fan._writes.erase(it);
+
+    auto sameTarget = [&write](const auto& other) {
+        return other->target == write->target;
+    };
+    if (sd_bus_message_is_method_error(msg, nullptr))
+    {
+        const auto* error = sd_bus_message_get_error(msg);
+        write->batch->fail(fmt::format(
+            "Failed to set target {} for fan {} on {} {}: {}", write->target,
+            fan._name, write->service, write->path,
+            (error && error->name) ? error->name : "unknown"));
+        write->failed = true;
+    }
+    if (write->failed)
+    {
+        // The target is not committed when any sensor fails to be written
+        for (auto& other : fan._writes)
+        {
+            if (sameTarget(other))
+            {
+                other->failed = true;
+            }
+        }
+        if (fan._pendingTarget == write->target)
+        {
+            fan._pendingTarget.reset();
+        }
+    }
+    else if (std::none_of(fan._writes.begin(), fan._writes.end(), sameTarget))
+    {
+        // All sensors have been written the target
+        fan._target = write->target;
+        if (fan._pendingTarget == write->target)
+        {
+            fan._pendingTarget.reset();
+        }
+    }
+
+    // Completing the batch logs the failures within it
+    write->batch->complete();
+
+    return 0;
+}
+
 void Fan::lockTarget(uint64_t target)
 {
     // if multiple locks, take highest, else allow only the
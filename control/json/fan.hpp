@@ -16,17 +16,76 @@
 #pragma once
 
 #include "config_base.hpp"
+#include "hwmon_sysfs.hpp"
+#include "sdbusplus.hpp"
+
+#include <systemd/sd-bus.h>
 
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 
 #include <map>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace phosphor::fan::control::json
 {
 
 using json = nlohmann::json;
 
+/**
+ * @class TargetBatch - Completion barrier of a batch of fan target writes
+ *
+ * Target writes to the fans' sensors are made asynchronously, so a batch of
+ * them is pipelined to the sensors' services rather than each write waiting
+ * on the reply of the previous one. The batch completes once all its writes
+ * have been replied to, at which point its write failures are logged. A
+ * failed write leaves its fan's target uncommitted, so the fan's next
+ * target request writes the target again.
+ *
+ * A batch is held open from its creation until complete() is called by its
+ * creator, after all its writes have been made.
+ */
+class TargetBatch
+{
+  public:
+    TargetBatch() = default;
+    TargetBatch(const TargetBatch&) = delete;
+    TargetBatch(TargetBatch&&) = delete;
+    TargetBatch& operator=(const TargetBatch&) = delete;
+    TargetBatch& operator=(TargetBatch&&) = delete;
+    ~TargetBatch() = default;
+
+    /**
+     * @brief Add a write to wait on
+     */
+    inline void add()
+    {
+        _pending++;
+    }
+
+    /**
+     * @brief Record a write failure
+     *
+     * @param[in] error - The failure of the write, naming the fan and sensor
+     */
+    void fail(std::string&& error);
+
+    /**
+     * @brief Complete a write, or the hold on the batch by its creator,
+     *        logging the failures recorded once every write has completed
+     */
+    void complete();
+
+  private:
+    /* Number of writes not completed, including the creator's hold */
+    size_t _pending = 1;
+
+    /* Write failures within the batch */
+    std::vector<std::string> _errors;
+};
+
 /**
  * @class Fan - Represents a configured fan control fan object
  *
@@ -39,6 +98,9 @@ using json = nlohmann::json;
  *
  * (When no profile for a fan is given, the fan defaults to always be included)
  *
+ * Fan targets are written through the sensors' D-Bus `Target` property, or
+ * optionally directly to the attributes of the fan controller's hwmon sysfs
+ * directory when configured with `hwmon`.
  */
 class Fan : public ConfigBase
 {
@@ -106,10 +168,25 @@ class Fan : public ConfigBase
     /**
      * Sets the target value on all contained sensors
      *
+     * The writes to the sensors are asynchronous, and the fan's target is
+     * only updated once they have all succeeded.
+     *
      * @param[in] target - The value to set
      */
     void setTarget(uint64_t target);
 
+    /**
+     * Sets the target value on all contained sensors as part of a batch of
+     * pipelined writes
+     *
+     * A write failing, including failing to be sent, is recorded in the
+     * batch and leaves the target uncommitted to be written again.
+     *
+     * @param[in] target - The value to set
+     * @param[in] batch - Batch to add the writes to
+     */
+    void setTarget(uint64_t target, const std::shared_ptr<TargetBatch>& batch);
+
   private:
     /**
      * Forces all contained sensors to the target (if this target is the
@@ -127,6 +204,55 @@ class Fan : public ConfigBase
      */
     void unlockTarget(uint64_t target);
 
+    /**
+     * An asynchronous write of a target to one of the fan's sensors
+     */
+    struct TargetWrite
+    {
+        /* Fan the write was made for */
+        Fan* fan;
+
+        /* Target written */
+        uint64_t target;
+
+        /* Sensor path and its service written to */
+        std::string path;
+        std::string service;
+
+        /* Whether another write of the same target failed */
+        bool failed;
+
+        /* Batch the write is a part of */
+        std::shared_ptr<TargetBatch> batch;
+
+        /* Slot of the write's method call, releasing it cancels the call */
+        std::unique_ptr<sd_bus_slot, decltype(&sd_bus_slot_unref)> slot{
+            nullptr, sd_bus_slot_unref};
+    };
+
+    /**
+     * @brief Callback of the reply to a target write
+     *
+     * Commits the written target once all the sensors' writes of it have
+     * succeeded, then completes the write within its batch.
+     *
+     * @param[in] msg - The reply message
+     * @param[in] data - The TargetWrite of the reply
+     * @param[in] error - Unused
+     *
+     * @return - Always 0
+     */
+    static int targetWritten(sd_bus_message* msg, void* data,
+                             sd_bus_error* error);
+
+    /**
+     * @brief Writes a target directly to the hwmon attributes of the sensors
+     *
+     * @param[in] target - The value to write
+     * @param[in] batch - Batch to record a failure of the writes in
+     */
+    void writeHwmonTarget(uint64_t target, TargetBatch& batch);
+
     /* The sdbusplus bus object */
     sdbusplus::bus::bus& _bus;
 
@@ -139,6 +265,13 @@ class Fan : public ConfigBase
     /* Target for this fan */
     uint64_t _target;
 
+    /* Target being written to the sensors, when not yet committed */
+    std::optional<uint64_t> _pendingTarget;
+
+    /* Target writes in flight, in the order they were made */
+    std::vector<std::unique_ptr<TargetWrite>> _writes;
+
+
     /* list of locked targets active on this fan */
     std::vector<uint64_t> _lockedTargets;
 
@@ -151,6 +284,12 @@ class Fan : public ConfigBase
     /* The zone this fan belongs to */
     std::string _zone;
 
+    /* Hwmon sysfs directory to write targets to instead of D-Bus */
+    std::unique_ptr<util::HwmonSysfs> _hwmon;
+
+    /* Map of sensors to their hwmon target attribute */
+    std::map<std::string, std::string> _hwmonAttrs;
+
     /**
      * @brief Parse and set the fan's sensor interface
      *
@@ -170,6 +309,17 @@ class Fan : public ConfigBase
      */
     void setSensors(const json& jsonObj);
 
+    /**
+     * @brief Parse and set the fan's optional hwmon sysfs target attributes
+     *
+     * @param[in] jsonObj - JSON object for the fan
+     *
+     * Sets the hwmon directory and the attribute of each sensor, i.e.
+     * `pwm1` or `fan1_target`, that targets are written to in place of the
+     * sensors' `Target` property on dbus.
+     */
+    void setHwmon(const json& jsonObj);
+
     /**
      * @brief Parse and set the fan's zone
      *
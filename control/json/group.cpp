@@ -38,6 +38,7 @@ Group::Group(const Group& origObj) : ConfigBase(origObj)
 {
     // Copy everything from the original Group object
     _members = origObj._members;
+    _slots = origObj._slots;
     _service = origObj._service;
     _interface = origObj.getInterface();
     _property = origObj.getProperty();
@@ -64,4 +65,20 @@ void Group::setService(const json& jsonObj)
     _service = jsonObj["service"].get<std::string>();
 }
 
+void Group::setSlots()
+{
+    _slots.clear();
+    if (_interface.empty() || _property.empty())
+    {
+        return;
+    }
+
+    auto& cache = PropertyCache::instance();
+    cache.addInterest(_interface, _property);
+    for (const auto& member : _members)
+    {
+        _slots.emplace_back(cache.getSlot(member, _interface, _property));
+    }
+}
+
 } // namespace phosphor::fan::control::json
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "config_base.hpp"
+#include "utils/property_cache.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -92,6 +93,7 @@ class Group : public ConfigBase
     inline void setInterface(const std::string& intf)
     {
         _interface = intf;
+        setSlots();
     }
 
     /**
@@ -108,6 +110,7 @@ class Group : public ConfigBase
     inline void setProperty(const std::string& prop)
     {
         _property = prop;
+        setSlots();
     }
 
     /**
@@ -150,10 +153,25 @@ class Group : public ConfigBase
         return _value;
     }
 
+    /**
+     * @brief Get the property cache slots of the members
+     *
+     * @return List of the property cache slots of the group's interface and
+     * property on each member, in the same order as the members. Groups
+     * configured on events always have both, so a slot for every member.
+     */
+    inline const auto& getSlots() const
+    {
+        return _slots;
+    }
+
   private:
     /* Members of the group */
     std::vector<std::string> _members;
 
+    /* Property cache slot of each member's interface and property */
+    std::vector<PropertySlot> _slots;
+
     /* Service name serving all the members */
     std::string _service;
 
@@ -189,6 +207,15 @@ class Group : public ConfigBase
      * configured events.
      */
     void setService(const json& jsonObj);
+
+    /**
+     * @brief Resolve the property cache slots of the members
+     *
+     * Resolves the slot of the group's interface and property for each member
+     * so the cached values can be accessed without any lookups by name. The
+     * slots are only resolved once both the interface and property are set.
+     */
+    void setSlots();
 };
 
 } // namespace phosphor::fan::control::json
@@ -26,10 +26,10 @@
 #include "profile.hpp"
 #include "sdbusplus.hpp"
 #include "utils/flight_recorder.hpp"
+#include "utils/property_cache.hpp"
+#include "utils/signal_message.hpp"
 #include "zone.hpp"
 
-#include <systemd/sd-bus.h>
-
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server/manager.hpp>
@@ -38,10 +38,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -55,13 +57,20 @@ std::vector<std::string> Manager::_activeProfiles;
 std::map<std::string,
          std::map<std::string, std::pair<bool, std::vector<std::string>>>>
     Manager::_servTree;
-std::map<std::string,
-         std::map<std::string, std::map<std::string, PropertyVariantType>>>
-    Manager::_objects;
+std::unordered_map<std::string,
+                   std::unordered_map<std::string, ServTreeEntry*>>
+    Manager::_servPaths;
+std::unordered_map<std::string,
+                   std::unordered_map<std::string, ServTreeEntry*>>
+    Manager::_pathIntfs;
+std::unordered_set<std::string> Manager::_subtreeIntfs;
+size_t Manager::_filteredProps = 0;
 std::unordered_map<std::string, PropertyVariantType> Manager::_parameters;
-std::unordered_map<std::string, TriggerActions> Manager::_parameterTriggers;
+std::unordered_map<std::string, std::pair<Profiler::ID, TriggerActions>>
+    Manager::_parameterTriggers;
 
 const std::string Manager::dumpFile = "/tmp/fan_control_dump.json";
+const std::string Manager::querySocket = "/run/fan_control_query.sock";
 
 Manager::Manager(const sdeventplus::Event& event) :
     _bus(util::SDBusPlus::getBus()), _event(event),
@@ -69,8 +78,27 @@ Manager::Manager(const sdeventplus::Event& event) :
     _powerState(std::make_unique<PGoodState>(
         util::SDBusPlus::getBus(),
         std::bind(std::mem_fn(&Manager::powerStateChanged), this,
-                  std::placeholders::_1)))
-{}
+                  std::placeholders::_1))),
+    _intfsAddedMatch(_bus, sdbusplus::bus::match::rules::interfacesAdded(),
+                     std::bind(std::mem_fn(&Manager::subtreeIntfsAdded), this,
+                               std::placeholders::_1)),
+    _introspectedMatch(_bus, util::introspectionComplete(),
+                       std::bind(std::mem_fn(&Manager::subtreeIntrospected),
+                                 this, std::placeholders::_1))
+{
+    try
+    {
+        _queryServer = std::make_unique<QueryServer>(
+            _event, querySocket,
+            std::bind(std::mem_fn(&Manager::queryDump), this,
+                      std::placeholders::_1));
+    }
+    catch (const std::runtime_error& e)
+    {
+        // Dump queries can still be answered from the dump file
+        log<level::ERR>(e.what());
+    }
+}
 
 void Manager::sighupHandler(sdeventplus::source::Signal&,
                             const struct signalfd_siginfo*)
@@ -96,14 +124,28 @@ void Manager::sighupHandler(sdeventplus::source::Signal&,
         log<level::ERR>("Error reloading configs, no changes made",
                         entry("LOAD_ERROR=%s", re.what()));
         FlightRecorder::instance().log(
-            "main", fmt::format("Error reloading configs, no changes made: {}",
-                                re.what()));
+            "main", "Error reloading configs, no changes made: {}", re.what());
     }
 }
 
 void Manager::sigUsr1Handler(sdeventplus::source::Signal&,
                              const struct signalfd_siginfo*)
 {
+    if (_debugDump)
+    {
+        // Already dumping
+        return;
+    }
+
+    auto dump = std::make_unique<DebugDump>();
+    dump->file.open(Manager::dumpFile + ".tmp");
+    if (!dump->file)
+    {
+        log<level::ERR>("Could not open file for fan dump");
+        return;
+    }
+    _debugDump = std::move(dump);
+
     debugDumpEventSource = std::make_unique<sdeventplus::source::Defer>(
         _event, std::bind(std::mem_fn(&Manager::dumpDebugData), this,
                           std::placeholders::_1));
@@ -111,52 +153,243 @@ void Manager::sigUsr1Handler(sdeventplus::source::Signal&,
 
 void Manager::dumpDebugData(sdeventplus::source::EventBase& /*source*/)
 {
-    json data;
-    FlightRecorder::instance().dump(data);
-    dumpCache(data);
-
-    std::for_each(_zones.begin(), _zones.end(), [&data](const auto& zone) {
-        data["zones"][zone.second->getName()] = zone.second->dump();
-    });
+    try
+    {
+        if (!dumpSlice())
+        {
+            // Continue on the next event loop iteration
+            return;
+        }
 
-    std::ofstream file{Manager::dumpFile};
-    if (!file)
+        _debugDump->file.close();
+        if (!_debugDump->file)
+        {
+            log<level::ERR>("Could not write file for fan dump");
+        }
+        else
+        {
+            // Only a complete dump is ever found at the dump file
+            std::filesystem::rename(Manager::dumpFile + ".tmp",
+                                    Manager::dumpFile);
+        }
+    }
+    catch (const std::exception& e)
     {
-        log<level::ERR>("Could not open file for fan dump");
-        return;
+        log<level::ERR>(
+            fmt::format("Failed writing fan dump: {}", e.what()).c_str());
     }
 
-    file << std::setw(4) << data;
-
+    _debugDump.reset();
     debugDumpEventSource.reset();
 }
 
-void Manager::dumpCache(json& data)
+bool Manager::dumpSlice()
 {
-    auto& objects = data["objects"];
-    for (const auto& [path, interfaces] : _objects)
-    {
-        auto& interfaceJSON = objects[path];
+    using Stage = DebugDump::Stage;
 
-        for (const auto& [interface, properties] : interfaces)
+    // Number of entries written per event loop iteration
+    constexpr size_t sliceSize = 256;
+
+    auto& dump = *_debugDump;
+    auto& writer = dump.writer;
+    const auto& cache = PropertyCache::instance();
+    for (size_t count = 0; count < sliceSize; count++)
+    {
+        switch (dump.stage)
         {
-            auto& propertyJSON = interfaceJSON[interface];
-            for (const auto& [propName, propValue] : properties)
+            case Stage::begin:
+            {
+                // The flight recorder is bounded by its entries per ID
+                json data;
+                FlightRecorder::instance().dump(data);
+
+                writer.beginObject();
+                writer.key("filtered_properties");
+                writer.value(_filteredProps);
+                writer.key("flight_recorder");
+                writer.value(data["flight_recorder"]);
+                writer.key("objects");
+                writer.beginObject();
+                dump.slots = cache.getSlotsByObject();
+                dump.stage = Stage::objects;
+                break;
+            }
+            case Stage::objects:
+            {
+                if (dump.nextSlot == dump.slots.size())
+                {
+                    // Close the objects
+                    while (writer.depth() > 1)
+                    {
+                        writer.endObject();
+                    }
+
+                    writer.key("parameters");
+                    writer.beginObject();
+                    for (const auto& [name, value] : _parameters)
+                    {
+                        writer.key(name);
+                        std::visit(
+                            [&writer](const auto& val) { writer.value(val); },
+                            value);
+                    }
+                    writer.endObject();
+
+                    // The profile is bounded by the actions and triggers
+                    json profile = json::object();
+                    Profiler::instance().dump(profile);
+                    writer.key("profile");
+                    writer.value(profile);
+
+                    writer.key("services");
+                    writer.beginObject();
+                    dump.stage = Stage::services;
+                    break;
+                }
+
+                // Skip values removed since the dump started
+                auto slot = dump.slots[dump.nextSlot++];
+                const auto* value = cache.get(slot);
+                if (value == nullptr)
+                {
+                    break;
+                }
+
+                const auto& [path, intf, prop] = cache.getNames(slot);
+                if (&path != dump.path)
+                {
+                    while (writer.depth() > 2)
+                    {
+                        writer.endObject();
+                    }
+                    writer.key(path);
+                    writer.beginObject();
+                    dump.path = &path;
+                    dump.intf = nullptr;
+                }
+                if (&intf != dump.intf)
+                {
+                    while (writer.depth() > 3)
+                    {
+                        writer.endObject();
+                    }
+                    writer.key(intf);
+                    writer.beginObject();
+                    dump.intf = &intf;
+                }
+                writer.key(prop);
+                std::visit([&writer](const auto& val) { writer.value(val); },
+                           *value);
+                break;
+            }
+            case Stage::services:
             {
-                std::visit(
-                    [&obj = propertyJSON[propName]](auto&& val) { obj = val; },
-                    propValue);
+                // Continue after the last path written, which stays valid
+                // when _servTree changes between slices
+                auto it = dump.lastService
+                              ? _servTree.upper_bound(*dump.lastService)
+                              : _servTree.begin();
+                if (it != _servTree.end())
+                {
+                    writer.key(it->first);
+                    writer.value(it->second);
+                    dump.lastService = it->first;
+                    break;
+                }
+                writer.endObject();
+
+                // There are only a few zones
+                writer.key("zones");
+                writer.beginObject();
+                for (const auto& [key, zone] : _zones)
+                {
+                    writer.key(zone->getName());
+                    writer.value(zone->dump());
+                }
+                writer.endObject();
+                writer.endObject();
+                dump.stage = Stage::end;
+                break;
             }
+            case Stage::end:
+                return true;
         }
     }
 
-    auto& parameters = data["parameters"];
-    for (const auto& [name, value] : _parameters)
+    return dump.stage == Stage::end;
+}
+
+json Manager::queryDump(const json& request)
+{
+    auto dq = DumpQuery::fromJson(request);
+    json section;
+    if (dq.section == "objects")
     {
-        std::visit([&obj = parameters[name]](auto&& val) { obj = val; }, value);
+        // Only the matching objects are taken from the cache
+        json output;
+        const auto& cache = PropertyCache::instance();
+        for (auto slot : cache.getSlotsByObject())
+        {
+            const auto& [path, intf, prop] = cache.getNames(slot);
+            if (!dq.matchesName(path))
+            {
+                continue;
+            }
+
+            json value;
+            std::visit([&value](const auto& val) { value = val; },
+                       cache.at(slot));
+            if (dq.properties.empty() || dq.hasProperty(intf))
+            {
+                output[path][intf][prop] = value;
+            }
+            if (dq.hasProperty(prop))
+            {
+                output[path][prop] = std::move(value);
+            }
+        }
+        return json{{"result", output}};
+    }
+    else if (dq.section == "flight_recorder")
+    {
+        json data;
+        FlightRecorder::instance().dump(data);
+        section = std::move(data["flight_recorder"]);
+    }
+    else if (dq.section == "parameters")
+    {
+        for (const auto& [name, value] : _parameters)
+        {
+            std::visit([&obj = section[name]](auto&& val) { obj = val; },
+                       value);
+        }
+    }
+    else if (dq.section == "profile")
+    {
+        Profiler::instance().dump(section);
+    }
+    else if (dq.section == "services")
+    {
+        section = _servTree;
+    }
+    else if (dq.section == "zones")
+    {
+        for (const auto& [key, zone] : _zones)
+        {
+            section[zone->getName()] = zone->dump();
+        }
+    }
+    else if (dq.section == "filtered_properties")
+    {
+        section = _filteredProps;
+    }
+    else
+    {
+        return json{{"error", fmt::format("Dump does not contain {} section",
+                                          dq.section)}};
     }
 
-    data["services"] = _servTree;
+    return json{{"result", dq.filter(section)}};
 }
 
 void Manager::load()
@@ -218,8 +451,20 @@ void Manager::load()
         // cache
         _timers.clear();
         _signals.clear();
+        _coalescedActions.clear();
+        _pendingActions.clear();
+        _pendingActionsEventSource.reset();
+        // Cancel method calls whose replies would run the replaced actions
+        _asyncCalls.clear();
+        // The new config may use properties the tracked objects didn't cache
+        for (auto& [key, tracked] : _trackedObjects)
+        {
+            tracked.synced = false;
+            tracked.generation++;
+        }
 
         // Enable events
+        preloadEvents(events);
         _events = std::move(events);
         std::for_each(_events.begin(), _events.end(),
                       [](const auto& entry) { entry.second->enable(); });
@@ -293,45 +538,36 @@ bool Manager::inConfig(const configKey& input, const configKey& comp)
 
 bool Manager::hasOwner(const std::string& path, const std::string& intf)
 {
-    auto itServ = _servTree.find(path);
-    if (itServ == _servTree.end())
+    auto entry = findServTreeEntry(path, intf);
+    if (entry == nullptr)
     {
-        // Path not found in cache, therefore owner missing
+        // Path or interface not found in cache, therefore owner missing
         return false;
     }
-    for (const auto& service : itServ->second)
-    {
-        auto itIntf = std::find_if(
-            service.second.second.begin(), service.second.second.end(),
-            [&intf](const auto& interface) { return intf == interface; });
-        if (itIntf != std::end(service.second.second))
-        {
-            // Service found, return owner state
-            return service.second.first;
-        }
-    }
-    // Interface not found in cache, therefore owner missing
-    return false;
+    // Service found, return owner state
+    return entry->second.first;
 }
 
 void Manager::setOwner(const std::string& serv, bool hasOwner)
 {
+    auto itServ = _servPaths.find(serv);
+    if (itServ == _servPaths.end())
+    {
+        return;
+    }
+
     // Update owner state on all entries of `serv`
-    for (auto& itPath : _servTree)
+    for (auto& [path, entry] : itServ->second)
     {
-        auto itServ = itPath.second.find(serv);
-        if (itServ != itPath.second.end())
-        {
-            itServ->second.first = hasOwner;
+        entry->second.first = hasOwner;
 
-            // Remove associated interfaces from object cache when service no
-            // longer has an owner
-            if (!hasOwner && _objects.find(itPath.first) != _objects.end())
+        // Remove associated interfaces from object cache when service no
+        // longer has an owner
+        if (!hasOwner)
+        {
+            for (auto& intf : entry->second.second)
             {
-                for (auto& intf : itServ->second.second)
-                {
-                    _objects[itPath.first].erase(intf);
-                }
+                removeInterface(path, intf);
             }
         }
     }
@@ -341,60 +577,80 @@ void Manager::setOwner(const std::string& path, const std::string& serv,
                        const std::string& intf, bool isOwned)
 {
     // Set owner state for specific object given
-    auto& ownIntf = _servTree[path][serv];
+    auto& ownIntf = addServTreeIntf(path, serv, intf);
     ownIntf.first = isOwned;
-    auto itIntf = std::find_if(
-        ownIntf.second.begin(), ownIntf.second.end(),
-        [&intf](const auto& interface) { return intf == interface; });
-    if (itIntf == std::end(ownIntf.second))
-    {
-        ownIntf.second.emplace_back(intf);
-    }
 
     // Update owner state on all entries of the same `serv` & `intf`
-    for (auto& itPath : _servTree)
+    for (auto& [servPath, entry] : _servPaths[serv])
     {
-        if (itPath.first == path)
+        if (servPath == path)
         {
             // Already set/updated owner on this path for `serv` & `intf`
             continue;
         }
-        for (auto& itServ : itPath.second)
+        auto& intfs = entry->second.second;
+        if (std::find(intfs.begin(), intfs.end(), intf) != intfs.end())
         {
-            if (itServ.first != serv)
-            {
-                continue;
-            }
-            auto itIntf = std::find_if(
-                itServ.second.second.begin(), itServ.second.second.end(),
-                [&intf](const auto& interface) { return intf == interface; });
-            if (itIntf != std::end(itServ.second.second))
-            {
-                itServ.second.first = isOwned;
-            }
+            entry->second.first = isOwned;
         }
     }
 }
 
+ServTreeEntry* Manager::findServTreeEntry(const std::string& path,
+                                          const std::string& intf)
+{
+    auto itPath = _pathIntfs.find(path);
+    if (itPath != _pathIntfs.end())
+    {
+        auto itIntf = itPath->second.find(intf);
+        if (itIntf != itPath->second.end())
+        {
+            return itIntf->second;
+        }
+    }
+
+    return nullptr;
+}
+
+std::pair<bool, std::vector<std::string>>&
+    Manager::addServTreeIntf(const std::string& path, const std::string& serv,
+                             const std::string& intf)
+{
+    // A service newly found providing a path defaults to having an owner
+    auto [itServ, added] =
+        _servTree[path].try_emplace(serv, true, std::vector<std::string>{});
+    auto& intfs = itServ->second.second;
+    if (std::find(intfs.begin(), intfs.end(), intf) == intfs.end())
+    {
+        intfs.emplace_back(intf);
+
+        // When multiple services provide the same path and interface, the
+        // first service in name order is used, same as a search through
+        // `_servTree` would find
+        auto& entry = _pathIntfs[path][intf];
+        if (entry == nullptr || serv < entry->first)
+        {
+            entry = &(*itServ);
+        }
+    }
+    if (added)
+    {
+        _servPaths[serv][path] = &(*itServ);
+    }
+
+    return itServ->second;
+}
+
 const std::string& Manager::findService(const std::string& path,
                                         const std::string& intf)
 {
     static const std::string empty = "";
 
-    auto itServ = _servTree.find(path);
-    if (itServ != _servTree.end())
+    auto entry = findServTreeEntry(path, intf);
+    if (entry != nullptr)
     {
-        for (const auto& service : itServ->second)
-        {
-            auto itIntf = std::find_if(
-                service.second.second.begin(), service.second.second.end(),
-                [&intf](const auto& interface) { return intf == interface; });
-            if (itIntf != std::end(service.second.second))
-            {
-                // Service found, return service name
-                return service.first;
-            }
-        }
+        // Service found, return service name
+        return entry->first;
     }
 
     return empty;
@@ -405,46 +661,30 @@ void Manager::addServices(const std::string& intf, int32_t depth)
     // Get all subtree objects for the given interface
     auto objects = util::SDBusPlus::getSubTreeRaw(util::SDBusPlus::getBus(),
                                                   "/", intf, depth);
+    if (depth == 0)
+    {
+        // Everything providing the interface is now cached
+        _subtreeIntfs.insert(intf);
+    }
     // Add what's returned to the cache of path->services
     for (auto& itPath : objects)
     {
         auto pathIter = _servTree.find(itPath.first);
-        if (pathIter != _servTree.end())
+        for (auto& itServ : itPath.second)
         {
-            // Path found in cache
-            for (auto& itServ : itPath.second)
+            if (pathIter != _servTree.end() &&
+                pathIter->second.find(itServ.first) != pathIter->second.end())
             {
-                auto servIter = pathIter->second.find(itServ.first);
-                if (servIter != pathIter->second.end())
-                {
-                    // Service found in cache
-                    for (auto& itIntf : itServ.second)
-                    {
-                        if (std::find(servIter->second.second.begin(),
-                                      servIter->second.second.end(),
-                                      itIntf) == servIter->second.second.end())
-                        {
-                            // Add interface to cache
-                            servIter->second.second.emplace_back(itIntf);
-                        }
-                    }
-                }
-                else
+                // Service found in cache, add any missing interfaces
+                for (auto& itIntf : itServ.second)
                 {
-                    // Service not found in cache
-                    auto intfs = {intf};
-                    pathIter->second[itServ.first] =
-                        std::make_pair(true, intfs);
+                    addServTreeIntf(itPath.first, itServ.first, itIntf);
                 }
             }
-        }
-        else
-        {
-            // Path not found in cache
-            auto intfs = {intf};
-            for (const auto& [servName, servIntfs] : itPath.second)
+            else
             {
-                _servTree[itPath.first][servName] = std::make_pair(true, intfs);
+                // Service not found in cache
+                addServTreeIntf(itPath.first, itServ.first, intf);
             }
         }
     }
@@ -455,7 +695,8 @@ const std::string& Manager::getService(const std::string& path,
 {
     // Retrieve service from cache
     const auto& serviceName = findService(path, intf);
-    if (serviceName.empty())
+    if (serviceName.empty() &&
+        (_subtreeIntfs.find(intf) == _subtreeIntfs.end()))
     {
         addServices(intf, 0);
         return findService(path, intf);
@@ -469,20 +710,15 @@ std::vector<std::string> Manager::findPaths(const std::string& serv,
 {
     std::vector<std::string> paths;
 
-    for (const auto& path : _servTree)
+    auto itServ = _servPaths.find(serv);
+    if (itServ != _servPaths.end())
     {
-        auto itServ = path.second.find(serv);
-        if (itServ != path.second.end())
+        for (const auto& [path, entry] : itServ->second)
         {
-            if (std::find(itServ->second.second.begin(),
-                          itServ->second.second.end(),
-                          intf) != itServ->second.second.end())
+            const auto& intfs = entry->second.second;
+            if (std::find(intfs.begin(), intfs.end(), intf) != intfs.end())
             {
-                if (std::find(paths.begin(), paths.end(), path.first) ==
-                    paths.end())
-                {
-                    paths.push_back(path.first);
-                }
+                paths.push_back(path);
             }
         }
     }
@@ -494,7 +730,7 @@ std::vector<std::string> Manager::getPaths(const std::string& serv,
                                            const std::string& intf)
 {
     auto paths = findPaths(serv, intf);
-    if (paths.empty())
+    if (paths.empty() && (_subtreeIntfs.find(intf) == _subtreeIntfs.end()))
     {
         addServices(intf, 0);
         return findPaths(serv, intf);
@@ -505,6 +741,7 @@ std::vector<std::string> Manager::getPaths(const std::string& serv,
 
 void Manager::insertFilteredObjects(ManagedObjects& ref)
 {
+    const auto& cache = PropertyCache::instance();
     for (auto& [path, pathMap] : ref)
     {
         for (auto& [intf, intfMap] : pathMap)
@@ -512,14 +749,281 @@ void Manager::insertFilteredObjects(ManagedObjects& ref)
             // for each property on this path+interface
             for (auto& [prop, value] : intfMap)
             {
-                setProperty(path, intf, prop, value);
+                if (!cache.isInterested(intf, prop))
+                {
+                    _filteredProps++;
+                    continue;
+                }
+                setProperty(path, intf, prop, std::move(value));
             }
         }
     }
 }
 
+std::shared_ptr<AsyncLoad> Manager::startLoad(std::function<void()> done)
+{
+    // Hold the load open until endLoad() is called
+    return std::make_shared<AsyncLoad>(1, std::move(done));
+}
+
+void Manager::endLoad(const std::shared_ptr<AsyncLoad>& load)
+{
+    completeLoad(load);
+}
+
+void Manager::completeLoad(const std::shared_ptr<AsyncLoad>& load)
+{
+    if (--load->first == 0 && load->second)
+    {
+        auto done = std::move(load->second);
+        done();
+    }
+}
+
+void Manager::callAsync(
+    const std::string& key, sdbusplus::message::message& msg,
+    std::function<void(sdbusplus::message::message&)> handler,
+    const std::shared_ptr<AsyncLoad>& load)
+{
+    auto it = _asyncCalls.find(key);
+    if (it == _asyncCalls.end())
+    {
+        auto call = std::make_unique<AsyncCall>();
+        call->mgr = this;
+        call->key = key;
+        call->handler = std::move(handler);
+
+        sd_bus_slot* slot = nullptr;
+        auto r = sd_bus_call_async(_bus.get(), &slot, msg.get(),
+                                   &Manager::asyncReply, call.get(), 0);
+        if (r < 0)
+        {
+            log<level::ERR>(
+                fmt::format("Unable to make method call {}: {}", key,
+                            strerror(-r))
+                    .c_str());
+            return;
+        }
+        call->slot.reset(slot);
+        it = _asyncCalls.emplace(key, std::move(call)).first;
+    }
+
+    load->first++;
+    it->second->loads.emplace_back(load);
+}
+
+int Manager::asyncReply(sd_bus_message* msg, void* data, sd_bus_error*)
+{
+    auto* mgr = static_cast<AsyncCall*>(data)->mgr;
+    auto it = mgr->_asyncCalls.find(static_cast<AsyncCall*>(data)->key);
+    if (it == mgr->_asyncCalls.end())
+    {
+        return 0;
+    }
+    // Take the call out of the calls in flight, releasing it when done
+    auto call = std::move(it->second);
+    mgr->_asyncCalls.erase(it);
+
+    try
+    {
+        sdbusplus::message::message reply{msg};
+        if (reply.is_method_error())
+        {
+            const auto* error = sd_bus_message_get_error(msg);
+            log<level::DEBUG>(
+                fmt::format("Method call {} failed: {}", call->key,
+                            (error && error->name) ? error->name : "unknown")
+                    .c_str());
+        }
+        else
+        {
+            call->handler(reply);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(fmt::format("Failed handling reply of method call "
+                                    "{}: {}",
+                                    call->key, e.what())
+                            .c_str());
+    }
+
+    for (const auto& load : call->loads)
+    {
+        try
+        {
+            completeLoad(load);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed completing load of method call {}: {}",
+                            call->key, e.what())
+                    .c_str());
+        }
+    }
+
+    return 0;
+}
+
+void Manager::getManagedObjectsAsync(const std::string& service,
+                                     const std::string& objMgrPath,
+                                     const std::shared_ptr<AsyncLoad>& load)
+{
+    auto msg = _bus.new_method_call(service.c_str(), objMgrPath.c_str(),
+                                    "org.freedesktop.DBus.ObjectManager",
+                                    "GetManagedObjects");
+    callAsync(fmt::format("{}:{}:GetManagedObjects", service, objMgrPath),
+              msg,
+              [this, service, objMgrPath](auto& reply) {
+                  ManagedObjects objects;
+                  reply.read(objects);
+
+                  // insert all objects but remove any NaN values
+                  insertFilteredObjects(objects);
+              },
+              load);
+}
+
+void Manager::trackManagedObjects(const std::string& service,
+                                  const std::string& objMgrPath,
+                                  const std::shared_ptr<AsyncLoad>& load)
+{
+    namespace rules = sdbusplus::bus::match::rules;
+
+    auto& tracked = _trackedObjects[std::make_pair(service, objMgrPath)];
+    if (tracked.matches.empty())
+    {
+        // Subscribe before getting the objects so no change is missed
+        auto added = rules::interfacesAdded(objMgrPath) +
+                     rules::sender(service);
+        auto removed = rules::interfacesRemoved(objMgrPath) +
+                       rules::sender(service);
+        auto changed =
+            rules::type::signal() + rules::sender(service) +
+            (objMgrPath != "/" ? rules::path_namespace(objMgrPath) : "") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::member("PropertiesChanged");
+        tracked.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            _bus, added,
+            std::bind(&Manager::trackedIntfsAdded, this,
+                      std::placeholders::_1)));
+        tracked.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            _bus, removed,
+            std::bind(&Manager::trackedIntfsRemoved, this,
+                      std::placeholders::_1)));
+        tracked.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            _bus, changed,
+            std::bind(&Manager::trackedPropertiesChanged, this,
+                      std::placeholders::_1)));
+        // Signals from a new owner aren't a continuation of the old owner's,
+        // so the objects need a resync
+        tracked.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            _bus, rules::nameOwnerChanged(service),
+            [&tracked](auto&) {
+                tracked.synced = false;
+                tracked.generation++;
+            }));
+    }
+
+    if (tracked.synced)
+    {
+        return;
+    }
+
+    // Only a call made after subscribing, and since the objects last needed
+    // a resync, gets a complete picture. So its key never joins another call
+    // in flight, like an untracked one made before the matches existed.
+    auto generation = tracked.generation;
+    auto msg = _bus.new_method_call(service.c_str(), objMgrPath.c_str(),
+                                    "org.freedesktop.DBus.ObjectManager",
+                                    "GetManagedObjects");
+    callAsync(
+        fmt::format("{}:{}:GetManagedObjects:tracked:{}", service, objMgrPath,
+                    generation),
+        msg,
+        [this, key = std::make_pair(service, objMgrPath),
+         generation](auto& reply) {
+            ManagedObjects objects;
+            reply.read(objects);
+
+            // insert all objects but remove any NaN values
+            insertFilteredObjects(objects);
+
+            auto tracked = _trackedObjects.find(key);
+            if ((tracked != _trackedObjects.end()) &&
+                (tracked->second.generation == generation))
+            {
+                tracked->second.synced = true;
+            }
+        },
+        load);
+}
+
+void Manager::trackedIntfsAdded(sdbusplus::message::message& msg)
+{
+    SignalMessage sigMsg{msg};
+    const auto& added = sigMsg.interfacesAdded();
+    const auto& cache = PropertyCache::instance();
+    for (const auto& [intf, props] : added.intfs)
+    {
+        for (const auto& [prop, value] : props)
+        {
+            if (cache.isInterested(intf, prop))
+            {
+                setProperty(added.path, intf, prop, value);
+            }
+        }
+    }
+}
+
+void Manager::trackedIntfsRemoved(sdbusplus::message::message& msg)
+{
+    SignalMessage sigMsg{msg};
+    const auto& removed = sigMsg.interfacesRemoved();
+    for (const auto& intf : removed.intfs)
+    {
+        removeInterface(removed.path, intf);
+    }
+}
+
+void Manager::trackedPropertiesChanged(sdbusplus::message::message& msg)
+{
+    SignalMessage sigMsg{msg};
+    const auto& path = sigMsg.objectPath();
+    const auto& changed = sigMsg.propertiesChanged();
+    const auto& cache = PropertyCache::instance();
+    for (const auto& [prop, value] : changed.props)
+    {
+        if (cache.isInterested(changed.intf, prop))
+        {
+            setProperty(path, changed.intf, prop, value);
+        }
+    }
+}
+
+void Manager::getPropertyAsync(const std::string& service,
+                               const std::string& path,
+                               const std::string& intf,
+                               const std::string& prop,
+                               const std::shared_ptr<AsyncLoad>& load)
+{
+    auto msg = _bus.new_method_call(service.c_str(), path.c_str(),
+                                    "org.freedesktop.DBus.Properties", "Get");
+    msg.append(intf, prop);
+    callAsync(fmt::format("{}:{}:{}:{}:Get", service, path, intf, prop), msg,
+              [this, path, intf, prop](auto& reply) {
+                  PropertyVariantType value;
+                  reply.read(value);
+
+                  setProperty(path, intf, prop, std::move(value));
+              },
+              load);
+}
+
 void Manager::addObjects(const std::string& path, const std::string& intf,
-                         const std::string& prop)
+                         const std::string& prop,
+                         const std::shared_ptr<AsyncLoad>& load, bool track)
 {
     auto service = getService(path, intf);
     if (service.empty())
@@ -537,22 +1041,21 @@ void Manager::addObjects(const std::string& path, const std::string& intf,
     {
         // No object manager interface provided by service?
         // Attempt to retrieve property directly
-        auto value = util::SDBusPlus::getPropertyVariant<PropertyVariantType>(
-            _bus, service, path, intf, prop);
-
-        setProperty(path, intf, prop, value);
+        getPropertyAsync(service, path, intf, prop, load);
         return;
     }
 
     for (const auto& objMgrPath : objMgrPaths)
     {
         // Get all managed objects of service
-        // want to filter here...
-        auto objects = util::SDBusPlus::getManagedObjects<PropertyVariantType>(
-            _bus, service, objMgrPath);
-
-        // insert all objects but remove any NaN values
-        insertFilteredObjects(objects);
+        if (track)
+        {
+            trackManagedObjects(service, objMgrPath, load);
+        }
+        else
+        {
+            getManagedObjectsAsync(service, objMgrPath, load);
+        }
     }
 }
 
@@ -562,17 +1065,13 @@ const std::optional<PropertyVariantType>
 {
     // TODO Objects hosted by fan control (i.e. ThermalMode) are required to
     // update the cache upon being set/updated
-    auto itPath = _objects.find(path);
-    if (itPath != _objects.end())
+    auto& cache = PropertyCache::instance();
+    auto slot = cache.findSlot(path, intf, prop);
+    if (slot)
     {
-        auto itIntf = itPath->second.find(intf);
-        if (itIntf != itPath->second.end())
+        if (const auto* value = cache.get(*slot))
         {
-            auto itProp = itIntf->second.find(prop);
-            if (itProp != itIntf->second.end())
-            {
-                return itProp->second;
-            }
+            return *value;
         }
     }
 
@@ -582,19 +1081,34 @@ const std::optional<PropertyVariantType>
 void Manager::setProperty(const std::string& path, const std::string& intf,
                           const std::string& prop, PropertyVariantType value)
 {
+    auto& cache = PropertyCache::instance();
     // filter NaNs out of the cache
     if (PropertyContainsNan(value))
     {
-        // dont use operator [] if paths dont exist
-        if (_objects.find(path) != _objects.end() &&
-            _objects[path].find(intf) != _objects[path].end())
+        // dont create a slot if the property was never cached
+        auto slot = cache.findSlot(path, intf, prop);
+        if (slot)
         {
-            _objects[path][intf].erase(prop);
+            cache.erase(*slot);
         }
     }
     else
     {
-        _objects[path][intf][prop] = std::move(value);
+        cache.set(cache.getSlot(path, intf, prop), std::move(value));
+    }
+}
+
+void Manager::setProperty(PropertySlot slot, PropertyVariantType value)
+{
+    auto& cache = PropertyCache::instance();
+    // filter NaNs out of the cache
+    if (PropertyContainsNan(value))
+    {
+        cache.erase(slot);
+    }
+    else
+    {
+        cache.set(slot, std::move(value));
     }
 }
 
@@ -604,8 +1118,10 @@ void Manager::addTimer(const TimerType type,
 {
     auto dataPtr =
         std::make_unique<TimerData>(std::make_pair(type, std::move(*pkg)));
-    Timer timer(_event,
-                std::bind(&Manager::timerExpired, this, std::ref(*dataPtr)));
+    auto profilerID = Profiler::instance().getID(
+        Profiler::triggers, "timer:" + std::get<std::string>(dataPtr->second));
+    Timer timer(_event, std::bind(&Manager::timerExpired, this,
+                                  std::ref(*dataPtr), profilerID));
     if (type == TimerType::repeating)
     {
         timer.restart(interval);
@@ -621,7 +1137,8 @@ void Manager::addTimer(const TimerType type,
     _timers.emplace_back(std::move(dataPtr), std::move(timer));
 }
 
-void Manager::addGroups(const std::vector<Group>& groups)
+void Manager::addGroups(const std::vector<Group>& groups,
+                        const std::shared_ptr<AsyncLoad>& load, bool track)
 {
     std::string lastServ;
     std::vector<std::string> objMgrPaths;
@@ -659,13 +1176,8 @@ void Manager::addGroups(const std::vector<Group>& groups)
                     {
                         // No object manager interface provided for group member
                         // Attempt to retrieve group member property directly
-                        auto value = util::SDBusPlus::getPropertyVariant<
-                            PropertyVariantType>(_bus, service, member,
-                                                 group.getInterface(),
-                                                 group.getProperty());
-
-                        setProperty(member, group.getInterface(),
-                                    group.getProperty(), value);
+                        getPropertyAsync(service, member, group.getInterface(),
+                                         group.getProperty(), load);
                         continue;
                     }
 
@@ -675,11 +1187,15 @@ void Manager::addGroups(const std::vector<Group>& groups)
                         for (const auto& objMgrPath : objMgrPaths)
                         {
                             // Get all managed objects from the service
-                            auto objects = util::SDBusPlus::getManagedObjects<
-                                PropertyVariantType>(_bus, service, objMgrPath);
-
-                            // Insert objects into cache
-                            insertFilteredObjects(objects);
+                            if (track)
+                            {
+                                trackManagedObjects(service, objMgrPath, load);
+                            }
+                            else
+                            {
+                                getManagedObjectsAsync(service, objMgrPath,
+                                                       load);
+                            }
                         }
                     }
                 }
@@ -694,18 +1210,155 @@ void Manager::addGroups(const std::vector<Group>& groups)
     }
 }
 
-void Manager::timerExpired(TimerData& data)
+void Manager::preloadEvents(
+    const std::map<configKey, std::unique_ptr<Event>>& events)
+{
+    static const std::string objMgrIntf = "org.freedesktop.DBus.ObjectManager";
+
+    // Group members whose property isn't cached yet
+    std::vector<std::pair<const Group*, std::string>> members;
+    std::set<std::string> intfs{objMgrIntf};
+    for (const auto& [key, event] : events)
+    {
+        if (!event->hasTrigger("init"))
+        {
+            continue;
+        }
+        for (const auto& group : event->getGroups())
+        {
+            for (const auto& member : group.getMembers())
+            {
+                if (!getProperty(member, group.getInterface(),
+                                 group.getProperty()))
+                {
+                    members.emplace_back(&group, member);
+                    intfs.insert(group.getInterface());
+                }
+            }
+        }
+    }
+    if (members.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        // Cache the services of all the interfaces with one mapper call
+        auto objects = util::SDBusPlus::getSubTreeRaw(
+            _bus, "/", std::vector<std::string>(intfs.begin(), intfs.end()),
+            0);
+        _subtreeIntfs.insert(intfs.begin(), intfs.end());
+        for (const auto& [path, servs] : objects)
+        {
+            for (const auto& [serv, servIntfs] : servs)
+            {
+                for (const auto& intf : servIntfs)
+                {
+                    if (intfs.find(intf) != intfs.end())
+                    {
+                        addServTreeIntf(path, serv, intf);
+                    }
+                }
+            }
+        }
+    }
+    catch (const util::DBusError& e)
+    {
+        // Leave it to the init triggers to look up each member
+        log<level::DEBUG>(
+            fmt::format("Unable to preload event groups: {}", e.what())
+                .c_str());
+        return;
+    }
+
+    auto load = startLoad(nullptr);
+    std::set<std::string> services;
+    for (const auto& [group, member] : members)
+    {
+        auto service = group->getService();
+        if (service.empty())
+        {
+            service = findService(member, group->getInterface());
+        }
+        if (service.empty())
+        {
+            continue;
+        }
+
+        // Same requests as addObjects() makes for the member
+        auto objMgrPaths = findPaths(service, objMgrIntf);
+        if (objMgrPaths.empty())
+        {
+            getPropertyAsync(service, member, group->getInterface(),
+                             group->getProperty(), load);
+        }
+        else if (services.insert(service).second)
+        {
+            for (const auto& objMgrPath : objMgrPaths)
+            {
+                getManagedObjectsAsync(service, objMgrPath, load);
+            }
+        }
+    }
+    endLoad(load);
+}
+
+void Manager::subtreeIntfsAdded(sdbusplus::message::message& msg)
 {
-    if (std::get<bool>(data.second))
+    if (_subtreeIntfs.empty())
     {
-        addGroups(std::get<const std::vector<Group>&>(data.second));
+        return;
     }
 
+    try
+    {
+        util::readInterfacesAdded(msg, [](auto, auto intf) {
+            auto it = _subtreeIntfs.find(std::string{intf});
+            if (it != _subtreeIntfs.end())
+            {
+                // Get the interface's services again on its next miss
+                _subtreeIntfs.erase(it);
+            }
+        });
+    }
+    catch (const util::DBusError& e)
+    {
+        log<level::DEBUG>(e.what());
+    }
+}
+
+void Manager::subtreeIntrospected(sdbusplus::message::message&)
+{
+    // Any miss cached since the service got its name, before the mapper
+    // knew its objects, is dropped along with the others
+    _subtreeIntfs.clear();
+}
+
+void Manager::timerExpired(TimerData& data, Profiler::ID profilerID)
+{
+    Profiler::Scope profile{profilerID};
+
     auto& actions =
         std::get<std::vector<std::unique_ptr<ActionBase>>&>(data.second);
-    // Perform the actions in the timer data
-    std::for_each(actions.begin(), actions.end(),
-                  [](auto& action) { action->run(); });
+    auto runActions = [&actions = actions]() {
+        // Perform the actions in the timer data
+        std::for_each(actions.begin(), actions.end(),
+                      [](auto& action) { action->run(); });
+    };
+
+    if (std::get<3>(data.second))
+    {
+        // Run the actions once the preloaded groups' data is received
+        auto load = startLoad(std::move(runActions));
+        addGroups(std::get<const std::vector<Group>&>(data.second), load,
+                  std::get<4>(data.second));
+        endLoad(load);
+    }
+    else
+    {
+        runActions();
+    }
 
     // Remove oneshot timers after they expired
     if (data.first == TimerType::oneshot)
@@ -724,29 +1377,88 @@ void Manager::timerExpired(TimerData& data)
 }
 
 void Manager::handleSignal(sdbusplus::message::message& msg,
-                           const std::vector<SignalPkg>* pkgs)
+                           const SignalPkgs* pkgs, Profiler::ID profilerID)
+{
+    Profiler::Scope profile{profilerID};
+
+    // Decode the message at most once for all the packages
+    SignalMessage sigMsg{msg};
+
+    const auto& path = sigMsg.objectPath();
+    auto itPath = pkgs->find(path);
+    if (itPath != pkgs->end())
+    {
+        handleSignalPkgs(sigMsg, itPath->second);
+    }
+    if (!path.empty())
+    {
+        // Also handle packages not subscribed for a specific path
+        itPath = pkgs->find("");
+        if (itPath != pkgs->end())
+        {
+            handleSignalPkgs(sigMsg, itPath->second);
+        }
+    }
+}
+
+void Manager::handleSignalPkgs(SignalMessage& sigMsg,
+                               const std::vector<SignalPkg>& pkgs)
 {
-    for (auto& pkg : *pkgs)
+    for (auto& pkg : pkgs)
     {
         // Handle the signal callback and only run the actions if the handler
         // updated the cache for the given SignalObject
-        if (std::get<SignalHandler>(pkg)(msg, std::get<SignalObject>(pkg),
+        if (std::get<SignalHandler>(pkg)(sigMsg, std::get<SignalObject>(pkg),
                                          *this))
         {
             // Perform the actions in the handler package
             auto& actions = std::get<TriggerActions>(pkg);
-            std::for_each(actions.begin(), actions.end(), [](auto& action) {
+            std::for_each(actions.begin(), actions.end(), [this](auto& action) {
                 if (action.get())
                 {
-                    action.get()->run();
+                    runSignalAction(*action.get());
                 }
             });
         }
-        // Only rewind message when not last package
-        if (&pkg != &pkgs->back())
-        {
-            sd_bus_message_rewind(msg.get(), true);
-        }
+    }
+}
+
+void Manager::coalesceActions(std::vector<std::unique_ptr<ActionBase>>& actions)
+{
+    for (auto& action : actions)
+    {
+        _coalescedActions.try_emplace(action.get(), _coalescedActions.size());
+    }
+}
+
+void Manager::runSignalAction(ActionBase& action)
+{
+    auto itAction = _coalescedActions.find(&action);
+    if (itAction == _coalescedActions.end())
+    {
+        action.run();
+        return;
+    }
+
+    _pendingActions.emplace(itAction->second, itAction->first);
+    if (!_pendingActionsEventSource)
+    {
+        _pendingActionsEventSource =
+            std::make_unique<sdeventplus::source::Defer>(
+                _event, std::bind(std::mem_fn(&Manager::runPendingActions),
+                                  this, std::placeholders::_1));
+    }
+}
+
+void Manager::runPendingActions(sdeventplus::source::EventBase& /*source*/)
+{
+    auto pending = std::move(_pendingActions);
+    _pendingActions.clear();
+    _pendingActionsEventSource.reset();
+
+    for (auto& [order, action] : pending)
+    {
+        action->run();
     }
 }
 
@@ -787,7 +1499,7 @@ void Manager::addParameterTrigger(
     if (it != _parameterTriggers.end())
     {
         std::for_each(actions.begin(), actions.end(),
-                      [&actList = it->second](auto& action) {
+                      [&actList = it->second.second](auto& action) {
                           actList.emplace_back(std::ref(action));
                       });
     }
@@ -798,7 +1510,9 @@ void Manager::addParameterTrigger(
                       [&triggerActions](auto& action) {
                           triggerActions.emplace_back(std::ref(action));
                       });
-        _parameterTriggers[name] = std::move(triggerActions);
+        _parameterTriggers[name] = std::make_pair(
+            Profiler::instance().getID(Profiler::triggers, "parameter:" + name),
+            std::move(triggerActions));
     }
 }
 
@@ -807,7 +1521,8 @@ void Manager::runParameterActions(const std::string& name)
     auto it = _parameterTriggers.find(name);
     if (it != _parameterTriggers.end())
     {
-        std::for_each(it->second.begin(), it->second.end(),
+        Profiler::Scope profile{it->second.first};
+        std::for_each(it->second.second.begin(), it->second.second.end(),
                       [](auto& action) { action.get()->run(); });
     }
 }
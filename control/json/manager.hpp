@@ -23,10 +23,17 @@
 #include "power_state.hpp"
 #include "profile.hpp"
 #include "sdbusplus.hpp"
+#include "utils/dump_query.hpp"
 #include "utils/flight_recorder.hpp"
+#include "utils/json_writer.hpp"
+#include "utils/profiler.hpp"
+#include "utils/property_cache.hpp"
+#include "utils/query_server.hpp"
+#include "utils/signal_message.hpp"
 #include "zone.hpp"
 
 #include <fmt/format.h>
+#include <systemd/sd-bus.h>
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/log.hpp>
@@ -37,10 +44,13 @@
 #include <sdeventplus/utility/timer.hpp>
 
 #include <chrono>
+#include <fstream>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -67,10 +77,12 @@ enum class TimerType
  * that run when the timer expires
  *      const std::vector<Group> = List of groups
  *      bool = If groups should be preloaded before actions are run
+ *      bool = If preloaded groups are kept current with signals instead
+ * of being gotten again each time the timer expires
  */
 using TimerPkg =
     std::tuple<std::string, std::vector<std::unique_ptr<ActionBase>>&,
-               const std::vector<Group>&, bool>;
+               const std::vector<Group>&, bool, bool>;
 /**
  * Data associated with a running timer that's used when it expires
  * Pair constructed of:
@@ -81,20 +93,29 @@ using TimerData = std::pair<TimerType, TimerPkg>;
 /* Dbus event timer */
 using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
 
-/* Dbus signal object */
+/**
+ * Dbus signal object
+ * Tuple constructed of:
+ *     std::string = Dbus object's path
+ *     std::string = Dbus object's interface
+ *     std::string = Dbus object's property
+ *     PropertySlot = Property cache slot of the path/interface/property
+ */
 constexpr auto Path = 0;
 constexpr auto Intf = 1;
 constexpr auto Prop = 2;
-using SignalObject = std::tuple<std::string, std::string, std::string>;
+constexpr auto Slot = 3;
+using SignalObject =
+    std::tuple<std::string, std::string, std::string, PropertySlot>;
 /* Dbus signal actions */
 using TriggerActions =
     std::vector<std::reference_wrapper<std::unique_ptr<ActionBase>>>;
 /**
- * Signal handler function that handles parsing a signal's message for a
- * particular signal object and stores the results in the manager
+ * Signal handler function that handles the decoded contents of a signal's
+ * message for a particular signal object and stores the results in the manager
  */
-using SignalHandler = std::function<bool(sdbusplus::message::message&,
-                                         const SignalObject&, Manager&)>;
+using SignalHandler =
+    std::function<bool(SignalMessage&, const SignalObject&, Manager&)>;
 /**
  * Package of data required when a signal is received
  * Tuple constructed of:
@@ -103,15 +124,21 @@ using SignalHandler = std::function<bool(sdbusplus::message::message&,
  *     TriggerActions = List of actions that are run when the signal is received
  */
 using SignalPkg = std::tuple<SignalHandler, SignalObject, TriggerActions>;
+/**
+ * Packages of a subscribed signal demultiplexed by the object path the signal
+ * is about. Packages for signals not about a specific object path, i.e.
+ * nameOwnerChanged, are stored under an empty path.
+ */
+using SignalPkgs = std::unordered_map<std::string, std::vector<SignalPkg>>;
 /**
  * Data associated to a subscribed signal
  * Tuple constructed of:
- *     std::unique_ptr<std::vector<SignalPkg>> =
- *         Pointer to list of the signal's packages
+ *     std::unique_ptr<SignalPkgs> =
+ *         Pointer to the signal's packages by object path
  *     std::unique_ptr<sdbusplus::bus::match_t> =
  *         Pointer to match holding the subscription to a signal
  */
-using SignalData = std::tuple<std::unique_ptr<std::vector<SignalPkg>>,
+using SignalData = std::tuple<std::unique_ptr<SignalPkgs>,
                               std::unique_ptr<sdbusplus::bus::match_t>>;
 
 /**
@@ -128,6 +155,24 @@ using Prop_v = std::string;
 using ManagedObjects =
     std::map<Path_v, std::map<Intf_v, std::map<Prop_v, PropertyVariantType>>>;
 
+/**
+ * Entry of the services cache for a single service on a path
+ * Pair constructed of:
+ *     std::string = Service name
+ *     std::pair<bool, std::vector<std::string>> =
+ *         Service's owner state and the interfaces it provides on the path
+ */
+using ServTreeEntry =
+    std::pair<const std::string, std::pair<bool, std::vector<std::string>>>;
+
+/**
+ * Completion state of a set of asynchronous requests populating the cache
+ * Pair constructed of:
+ *     size_t = Number of requests not yet completed
+ *     std::function<void()> = Function to run once all requests completed
+ */
+using AsyncLoad = std::pair<size_t, std::function<void()>>;
+
 /**
  * Actions to run when a parameter trigger runs.
  */
@@ -278,7 +323,7 @@ class Manager
 
     /**
      * @brief Sets the dbus service owner state for all entries in the _servTree
-     * cache and removes associated objects from the _objects cache
+     * cache and removes associated objects from the property cache
      *
      * @param[in] serv - Dbus service name
      * @param[in] hasOwner - Dbus service owner state
@@ -311,7 +356,7 @@ class Manager
     /**
      * @brief Get the service for a given path and interface from cached
      * dataset and attempt to add all the services for the given path/interface
-     * when it's not found
+     * when it's not found, unless they were all added already
      *
      * @param[in] path - Path to get service for
      * @param[in] intf - Interface to get service for
@@ -327,8 +372,8 @@ class Manager
     /**
      * @brief Get all the object paths for a given service and interface from
      * the cached dataset and try to add all the services for the given
-     * interface when no paths are found and then attempt to get all the object
-     * paths again
+     * interface when no paths are found, unless they were all added already,
+     * and then attempt to get all the object paths again
      *
      * @param[in] serv - Service name to get paths for
      * @param[in] intf - Interface to get paths for
@@ -338,22 +383,50 @@ class Manager
     std::vector<std::string> getPaths(const std::string& serv,
                                       const std::string& intf);
 
+    /**
+     * @brief Start a load of asynchronous requests populating the cache
+     *
+     * The load is given to each request to wait on, and the given function
+     * is run once endLoad() is called and all those requests have completed.
+     *
+     * @param[in] done - Function to run once the load completes
+     *
+     * @return - The load to give to the requests
+     */
+    std::shared_ptr<AsyncLoad> startLoad(std::function<void()> done);
+
+    /**
+     * @brief End adding requests to a load, running its function now when
+     * none of its requests are still in flight
+     *
+     * @param[in] load - The load to end
+     */
+    void endLoad(const std::shared_ptr<AsyncLoad>& load);
+
     /**
      * @brief Add objects to the cached dataset by first using
      * `getManagedObjects` for the same service providing the given path and
      * interface or just add the single object of the given path, interface, and
      * property if that fails.
      *
+     * The method calls are made asynchronously, with the objects added to the
+     * cache when their replies are received. A call for the same objects that
+     * is already in flight is waited on rather than made again.
+     *
      * @param[in] path - Dbus object's path
      * @param[in] intf - Dbus object's interface
      * @param[in] prop - Dbus object's property
+     * @param[in] load - Load to wait on the method calls
+     * @param[in] track - If the service's managed objects are kept current
+     * with signals, only getting them again when they need a resync
      *
      * @throws - DBusMethodError
-     * Throws a DBusMethodError when the the service is failed to be found or
-     * when the `getManagedObjects` method call fails
+     * Throws a DBusMethodError when the the service is failed to be found
      */
     void addObjects(const std::string& path, const std::string& intf,
-                    const std::string& prop);
+                    const std::string& prop,
+                    const std::shared_ptr<AsyncLoad>& load,
+                    bool track = false);
 
     /**
      * @brief Get an object's property value
@@ -377,6 +450,14 @@ class Manager
     void setProperty(const std::string& path, const std::string& intf,
                      const std::string& prop, PropertyVariantType value);
 
+    /**
+     * @brief Set/update an object's property value by its cache slot
+     *
+     * @param[in] slot - Property cache slot of the object's property
+     * @param[in] value - Dbus object's property value
+     */
+    void setProperty(PropertySlot slot, PropertyVariantType value);
+
     /**
      * @brief Remove an object's interface
      *
@@ -386,11 +467,7 @@ class Manager
     inline void removeInterface(const std::string& path,
                                 const std::string& intf)
     {
-        auto itPath = _objects.find(path);
-        if (itPath != std::end(_objects))
-        {
-            _objects[path].erase(intf);
-        }
+        PropertyCache::instance().removeInterface(path, intf);
     }
 
     /**
@@ -401,12 +478,35 @@ class Manager
      * @param[in] prop - Name of property
      *
      * @return - The object's property value as a variant
+     *
+     * @throws - std::out_of_range when the property is not cached
      */
-    static inline auto getObjValueVariant(const std::string& path,
-                                          const std::string& intf,
-                                          const std::string& prop)
+    static inline const PropertyVariantType&
+        getObjValueVariant(const std::string& path, const std::string& intf,
+                           const std::string& prop)
     {
-        return _objects.at(path).at(intf).at(prop);
+        auto& cache = PropertyCache::instance();
+        auto slot = cache.findSlot(path, intf, prop);
+        if (!slot)
+        {
+            throw std::out_of_range("Property not found in cache");
+        }
+        return cache.at(*slot);
+    };
+
+    /**
+     * @brief Get the object's property value as a variant by its cache slot
+     *
+     * @param[in] slot - Property cache slot of the object's property
+     *
+     * @return - The object's property value as a variant
+     *
+     * @throws - std::out_of_range when the property is not cached
+     */
+    static inline const PropertyVariantType&
+        getObjValueVariant(PropertySlot slot)
+    {
+        return PropertyCache::instance().at(slot);
     };
 
     /**
@@ -424,8 +524,9 @@ class Manager
      * @brief Callback when a timer expires
      *
      * @param[in] data - Data to be used when the timer expired
+     * @param[in] profilerID - Profiler ID of the timer
      */
-    void timerExpired(TimerData& data);
+    void timerExpired(TimerData& data, Profiler::ID profilerID);
 
     /**
      * @brief Get the signal data for a given match string
@@ -442,11 +543,28 @@ class Manager
     /**
      * @brief Handle receiving signals
      *
+     * Only the packages subscribed for the object path the signal is about,
+     * along with any packages not subscribed for a specific path, are handled.
+     *
      * @param[in] msg - Signal message containing the signal's data
      * @param[in] pkgs - Signal packages associated to the signal being handled
+     * @param[in] profilerID - Profiler ID of the signal's match
+     */
+    void handleSignal(sdbusplus::message::message& msg, const SignalPkgs* pkgs,
+                      Profiler::ID profilerID);
+
+    /**
+     * @brief Coalesce the running of the given actions from signals
+     *
+     * Coalesced actions are not run when a signal they are triggered by is
+     * received. Instead, they are marked as pending and each pending action
+     * is run once, in the order they were coalesced, at the end of the
+     * current event loop iteration. This way a burst of signals results in
+     * the actions being run only once.
+     *
+     * @param[in] actions - The actions to coalesce
      */
-    void handleSignal(sdbusplus::message::message& msg,
-                      const std::vector<SignalPkg>* pkgs);
+    void coalesceActions(std::vector<std::unique_ptr<ActionBase>>& actions);
 
     /**
      * @brief Get the sdbusplus bus object
@@ -550,6 +668,25 @@ class Manager
     /* The name of the dump file */
     static const std::string dumpFile;
 
+    /* The path of the socket dump queries are served on */
+    static const std::string querySocket;
+
+    /**
+     * @brief Answer a query of a debug dump section from the current data,
+     * without writing a dump
+     *
+     * Objects are taken from the property cache only when they match the
+     * query, and the other sections are filtered the same as when queried
+     * from the dump file.
+     *
+     * @param[in] request - The DumpQuery as JSON
+     *
+     * @return - The matching entries as "result", or an "error"
+     *
+     * @throws - nlohmann::json::exception when the request is invalid
+     */
+    json queryDump(const json& request);
+
   private:
     /**
      * @brief Helper to detect when a property's double contains a NaN
@@ -565,15 +702,155 @@ class Manager
 
     /**
      * @brief Insert managed objects into cache, but filter out properties
-     * containing unwanted NaN (not-a-number) values.
+     * containing unwanted NaN (not-a-number) values and properties that
+     * aren't of interest to any group or action.
      *
      * @param[in] ref - The map of ManagedObjects to insert into cache
      */
     void insertFilteredObjects(ManagedObjects& ref);
 
+    /**
+     * Data of an asynchronous method call in flight
+     */
+    struct AsyncCall
+    {
+        /* Manager that made the call */
+        Manager* mgr;
+
+        /* Key of the call within the calls in flight */
+        std::string key;
+
+        /* Function to handle a successful reply to the call */
+        std::function<void(sdbusplus::message::message&)> handler;
+
+        /* Loads waiting on the call to complete */
+        std::vector<std::shared_ptr<AsyncLoad>> loads;
+
+        /* Slot of the call, releasing it cancels the call */
+        std::unique_ptr<sd_bus_slot, decltype(&sd_bus_slot_unref)> slot{
+            nullptr, sd_bus_slot_unref};
+    };
+
+    /**
+     * @brief Make an asynchronous method call, or wait on the same call when
+     * it's already in flight
+     *
+     * @param[in] key - Unique key of the method call
+     * @param[in] msg - The method call message
+     * @param[in] handler - Function to handle a successful reply
+     * @param[in] load - Load to wait on the call
+     */
+    void callAsync(const std::string& key, sdbusplus::message::message& msg,
+                   std::function<void(sdbusplus::message::message&)> handler,
+                   const std::shared_ptr<AsyncLoad>& load);
+
+    /**
+     * @brief Callback of asynchronous method call replies
+     *
+     * @param[in] msg - The reply message
+     * @param[in] data - The AsyncCall of the reply
+     * @param[in] error - Unused
+     *
+     * @return - Always 0 since failures are only logged
+     */
+    static int asyncReply(sd_bus_message* msg, void* data, sd_bus_error* error);
+
+    /**
+     * @brief Asynchronously add all the managed objects of a service's object
+     * manager path to the cache
+     *
+     * @param[in] service - Service name
+     * @param[in] objMgrPath - Path of the service's object manager
+     * @param[in] load - Load to wait on the method call
+     */
+    void getManagedObjectsAsync(const std::string& service,
+                                const std::string& objMgrPath,
+                                const std::shared_ptr<AsyncLoad>& load);
+
+    /**
+     * @brief Asynchronously add all the managed objects of a service's object
+     * manager path to the cache and keep them current with the service's
+     * InterfacesAdded, InterfacesRemoved, and PropertiesChanged signals
+     *
+     * Once added, the managed objects are only gotten again when they need a
+     * resync, like after the service's owner changed or a config reload.
+     *
+     * @param[in] service - Service name
+     * @param[in] objMgrPath - Path of the service's object manager
+     * @param[in] load - Load to wait on the method call
+     */
+    void trackManagedObjects(const std::string& service,
+                             const std::string& objMgrPath,
+                             const std::shared_ptr<AsyncLoad>& load);
+
+    /**
+     * @brief Add the interfaces of a tracked object manager's InterfacesAdded
+     * signal to the cache
+     *
+     * @param[in] msg - The InterfacesAdded signal
+     */
+    void trackedIntfsAdded(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Remove the interfaces of a tracked object manager's
+     * InterfacesRemoved signal from the cache
+     *
+     * @param[in] msg - The InterfacesRemoved signal
+     */
+    void trackedIntfsRemoved(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Update the cache with the properties of a PropertiesChanged
+     * signal within a tracked object manager's path
+     *
+     * @param[in] msg - The PropertiesChanged signal
+     */
+    void trackedPropertiesChanged(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Asynchronously add a single property to the cache
+     *
+     * @param[in] service - Service name
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     * @param[in] prop - Dbus object's property
+     * @param[in] load - Load to wait on the method call
+     */
+    void getPropertyAsync(const std::string& service, const std::string& path,
+                          const std::string& intf, const std::string& prop,
+                          const std::shared_ptr<AsyncLoad>& load);
+
+    /**
+     * @brief Complete a request of a load, running the load's function when
+     * it was the last request
+     *
+     * @param[in] load - The load of the completed request
+     */
+    static void completeLoad(const std::shared_ptr<AsyncLoad>& load);
+
     /* The sdbusplus bus object to use */
     sdbusplus::bus::bus& _bus;
 
+    /**
+     * Managed objects of a service's object manager kept current with signals
+     */
+    struct TrackedObjects
+    {
+        /* If the cache has the objects since they last needed a resync */
+        bool synced = false;
+
+        /* Number of resyncs needed, so only a reply to a call made since the
+         * last one can mark the objects synced */
+        size_t generation = 0;
+
+        /* Signal subscriptions keeping the objects current */
+        std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+    };
+
+    /* Tracked managed objects keyed by service and object manager path */
+    std::map<std::pair<std::string, std::string>, TrackedObjects>
+        _trackedObjects;
+
     /* The sdeventplus even loop to use */
     sdeventplus::Event _event;
 
@@ -586,6 +863,12 @@ class Manager
     /* The system's power state determination object */
     std::unique_ptr<PowerState> _powerState;
 
+    /* Match to forget missing objects when interfaces are added */
+    sdbusplus::bus::match_t _intfsAddedMatch;
+
+    /* Match to forget missing objects when the mapper finds a new service */
+    sdbusplus::bus::match_t _introspectedMatch;
+
     /* List of profiles configured */
     std::map<configKey, std::unique_ptr<Profile>> _profiles;
 
@@ -598,11 +881,27 @@ class Manager
         std::map<std::string, std::pair<bool, std::vector<std::string>>>>
         _servTree;
 
-    /* Object map of paths to interfaces of properties and their values */
-    static std::map<
-        std::string,
-        std::map<std::string, std::map<std::string, PropertyVariantType>>>
-        _objects;
+    /* Index of service names to their _servTree entry on each path */
+    static std::unordered_map<std::string,
+                              std::unordered_map<std::string, ServTreeEntry*>>
+        _servPaths;
+
+    /* Index of paths to the _servTree entry providing each interface */
+    static std::unordered_map<std::string,
+                              std::unordered_map<std::string, ServTreeEntry*>>
+        _pathIntfs;
+
+    /**
+     * Interfaces whose services on every path have been added to
+     * `_servTree`, so a path or service not found there with one of them
+     * doesn't exist on D-Bus. Misses on these interfaces are answered from
+     * the cache until an interface is added or the mapper finished
+     * introspecting a new service.
+     */
+    static std::unordered_set<std::string> _subtreeIntfs;
+
+    /* Number of managed object properties not of interest left uncached */
+    static size_t _filteredProps;
 
     /* List of timers and their data to be processed when expired */
     std::vector<std::pair<std::unique_ptr<TimerData>, Timer>> _timers;
@@ -620,6 +919,60 @@ class Manager
      * data from the event loop after the USR1 signal.  */
     std::unique_ptr<sdeventplus::source::Defer> debugDumpEventSource;
 
+    /**
+     * State of a debug dump being written across event loop iterations
+     */
+    struct DebugDump
+    {
+        /* Stages of the dump, in the order its sections are written */
+        enum class Stage
+        {
+            begin,
+            objects,
+            services,
+            end
+        };
+
+        /* The file being written, renamed to the dump file once complete */
+        std::ofstream file;
+
+        /* Writer of the JSON to the file */
+        JsonWriter writer{file};
+
+        /* The stage being written */
+        Stage stage = Stage::begin;
+
+        /* Cache slots to write, ordered by object, and the next one */
+        std::vector<PropertySlot> slots;
+        size_t nextSlot = 0;
+
+        /* Path and interface of the cache object being written */
+        const std::string* path = nullptr;
+        const std::string* intf = nullptr;
+
+        /* The last path of the services written */
+        std::optional<std::string> lastService;
+    };
+
+    /* The debug dump being written */
+    std::unique_ptr<DebugDump> _debugDump;
+
+    /* Server of dump queries */
+    std::unique_ptr<QueryServer> _queryServer;
+
+    /* Coalesced actions mapped to the order they were coalesced in */
+    std::unordered_map<ActionBase*, size_t> _coalescedActions;
+
+    /* Coalesced actions pending to be run, keyed by their coalesced order */
+    std::map<size_t, ActionBase*> _pendingActions;
+
+    /* The sdeventplus wrapper around sd_event_add_defer to run the pending
+     * coalesced actions at the end of the event loop iteration. */
+    std::unique_ptr<sdeventplus::source::Defer> _pendingActionsEventSource;
+
+    /* Asynchronous method calls in flight, keyed by their unique keys */
+    std::unordered_map<std::string, std::unique_ptr<AsyncCall>> _asyncCalls;
+
     /**
      * @brief A map of parameter names and values that are something
      *        other than just D-Bus property values that other actions
@@ -628,10 +981,12 @@ class Manager
     static std::unordered_map<std::string, PropertyVariantType> _parameters;
 
     /**
-     * @brief Map of parameter names to the actions to run when their
-     *        values change.
+     * @brief Map of parameter names to the profiler ID of the trigger and
+     *        the actions to run when their values change.
      */
-    static std::unordered_map<std::string, TriggerActions> _parameterTriggers;
+    static std::unordered_map<std::string,
+                              std::pair<Profiler::ID, TriggerActions>>
+        _parameterTriggers;
 
     /**
      * @brief Callback for power state changes
@@ -655,6 +1010,35 @@ class Manager
     static const std::string& findService(const std::string& path,
                                           const std::string& intf);
 
+    /**
+     * @brief Find the _servTree entry of the service providing a given path
+     * and interface
+     *
+     * @param[in] path - Path to get the entry for
+     * @param[in] intf - Interface to get the entry for
+     *
+     * @return - Pointer to the cached entry, or nullptr if not cached
+     */
+    static ServTreeEntry* findServTreeEntry(const std::string& path,
+                                            const std::string& intf);
+
+    /**
+     * @brief Add an interface provided by a service on a path to the
+     * _servTree cache and its indexes
+     *
+     * A service not yet cached on the path is added with an owner.
+     *
+     * @param[in] path - Dbus object path
+     * @param[in] serv - Dbus service name
+     * @param[in] intf - Dbus object interface
+     *
+     * @return - The cached owner state and interfaces of the service on the
+     * path
+     */
+    static std::pair<bool, std::vector<std::string>>&
+        addServTreeIntf(const std::string& path, const std::string& serv,
+                        const std::string& intf);
+
     /**
      * @brief Find all the paths for a given service and interface from the
      * cached dataset
@@ -678,23 +1062,92 @@ class Manager
     void setProfiles();
 
     /**
-     * @brief Callback from debugDumpEventSource to dump debug data
+     * @brief Run the handlers of a list of signal packages against a signal,
+     * running the actions of each package whose handler updated the cache
+     *
+     * @param[in] sigMsg - The decoded signal message
+     * @param[in] pkgs - Signal packages to handle the signal with
+     */
+    void handleSignalPkgs(SignalMessage& sigMsg,
+                          const std::vector<SignalPkg>& pkgs);
+
+    /**
+     * @brief Run an action triggered by a signal, or mark it pending when the
+     * action is coalesced
+     *
+     * @param[in] action - The action to run
+     */
+    void runSignalAction(ActionBase& action);
+
+    /**
+     * @brief Callback from _pendingActionsEventSource to run all the pending
+     * coalesced actions
+     */
+    void runPendingActions(sdeventplus::source::EventBase&);
+
+    /**
+     * @brief Callback from debugDumpEventSource to dump debug data, writing
+     * a slice of it on each event loop iteration until complete
      */
     void dumpDebugData(sdeventplus::source::EventBase&);
 
     /**
-     * @brief Dump the _objects, _servTree, and _parameters maps to JSON
+     * @brief Write the next slice of the debug dump
+     *
+     * The flight recorder, property cache, _parameters, _servTree, and zones
+     * are written to the dump a bounded number of entries at a time, so the
+     * event loop is never blocked by a large dump and the dump is never built
+     * in memory in full.
+     *
+     * @return - If the dump is complete
+     */
+    bool dumpSlice();
+
+    /**
+     * @brief Callback for InterfacesAdded signals that forgets the missing
+     *        paths and services of the interfaces added
+     *
+     * @param[in] msg - The InterfacesAdded signal
+     */
+    void subtreeIntfsAdded(sdbusplus::message::message& msg);
+
+    /**
+     * @brief Callback for the mapper's IntrospectionComplete signals that
+     *        forgets all missing paths and services once the mapper knows
+     *        a new service, since its interfaces aren't known
      *
-     * @param[out] data - The JSON that will be filled in
+     * @param[in] msg - The IntrospectionComplete signal
      */
-    void dumpCache(json& data);
+    void subtreeIntrospected(sdbusplus::message::message& msg);
 
     /**
      * @brief Add a list of groups to the cache dataset.
      *
+     * The method calls are made asynchronously, the same as addObjects().
+     *
      * @param[in] groups - The groups to add
+     * @param[in] load - Load to wait on the method calls
+     * @param[in] track - If the services' managed objects are kept current
+     * with signals, only getting them again when they need a resync
+     */
+    void addGroups(const std::vector<Group>& groups,
+                   const std::shared_ptr<AsyncLoad>& load, bool track = false);
+
+    /**
+     * @brief Request the data of the init triggered events' groups ahead
+     *        of enabling the events
+     *
+     * Instead of each group member's cache miss making its own mapper and
+     * method calls, the services of all the members not cached yet are
+     * found with a single GetSubTree of all their interfaces, and each
+     * service's managed objects are requested once. The method calls are
+     * made asynchronously, so the init triggers' requests for the same
+     * data wait on these instead of making new ones.
+     *
+     * @param[in] events - The events about to be enabled
      */
-    void addGroups(const std::vector<Group>& groups);
+    void preloadEvents(
+        const std::map<configKey, std::unique_ptr<Event>>& events);
 };
 
 } // namespace phosphor::fan::control::json
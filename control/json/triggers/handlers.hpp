@@ -1,19 +1,15 @@
 #pragma once
 
 #include "../manager.hpp"
-
-#include <sdbusplus/message.hpp>
+#include "../utils/signal_message.hpp"
 
 #include <algorithm>
-#include <map>
 #include <tuple>
 #include <vector>
 
 namespace phosphor::fan::control::json::trigger::signal
 {
 
-using namespace sdbusplus::message;
-
 struct Handlers
 {
 
@@ -22,32 +18,29 @@ struct Handlers
      * @brief Processes a properties changed signal and updates the property's
      * value in the manager's object cache
      *
-     * @param[in] msg - The sdbusplus signal message
+     * @param[in] msg - The decoded signal message
      * @param[in] obj - Object data associated with the signal
      * @param[in] mgr - Manager that stores the object cache
      */
-    static bool propertiesChanged(message& msg, const SignalObject& obj,
+    static bool propertiesChanged(SignalMessage& msg, const SignalObject& obj,
                                   Manager& mgr)
     {
-        std::string intf;
-        msg.read(intf);
-        if (intf != std::get<Intf>(obj))
+        const auto& changed = msg.propertiesChanged();
+        if (changed.intf != std::get<Intf>(obj))
         {
             // Interface name does not match object's interface
             return false;
         }
 
-        std::map<std::string, PropertyVariantType> props;
-        msg.read(props);
-        auto itProp = props.find(std::get<Prop>(obj));
-        if (itProp == props.cend())
+        auto value =
+            SignalMessage::findProperty(changed.props, std::get<Prop>(obj));
+        if (value == nullptr)
         {
             // Object's property not in dictionary of properties changed
             return false;
         }
 
-        mgr.setProperty(std::get<Path>(obj), std::get<Intf>(obj),
-                        std::get<Prop>(obj), itProp->second);
+        mgr.setProperty(std::get<Slot>(obj), *value);
         return true;
     }
 
@@ -55,40 +48,39 @@ struct Handlers
      * @brief Processes an interfaces added signal and adds the interface
      * (including property & property value) to the manager's object cache
      *
-     * @param[in] msg - The sdbusplus signal message
+     * @param[in] msg - The decoded signal message
      * @param[in] obj - Object data associated with the signal
      * @param[in] mgr - Manager that stores the object cache
      */
-    static bool interfacesAdded(message& msg, const SignalObject& obj,
+    static bool interfacesAdded(SignalMessage& msg, const SignalObject& obj,
                                 Manager& mgr)
     {
-        sdbusplus::message::object_path op;
-        msg.read(op);
-        if (static_cast<const std::string&>(op) != std::get<Path>(obj))
+        const auto& added = msg.interfacesAdded();
+        if (added.path != std::get<Path>(obj))
         {
             // Path name does not match object's path
             return false;
         }
 
-        std::map<std::string, std::map<std::string, PropertyVariantType>>
-            intfProps;
-        msg.read(intfProps);
-        auto itIntf = intfProps.find(std::get<Intf>(obj));
-        if (itIntf == intfProps.cend())
+        auto itIntf = std::find_if(added.intfs.begin(), added.intfs.end(),
+                                   [&obj](const auto& intf) {
+                                       return intf.first == std::get<Intf>(obj);
+                                   });
+        if (itIntf == added.intfs.cend())
         {
             // Object's interface not in dictionary of interfaces added
             return false;
         }
 
-        auto itProp = itIntf->second.find(std::get<Prop>(obj));
-        if (itProp == itIntf->second.cend())
+        auto value =
+            SignalMessage::findProperty(itIntf->second, std::get<Prop>(obj));
+        if (value == nullptr)
         {
             // Object's property not in dictionary of properties of interface
             return false;
         }
 
-        mgr.setProperty(std::get<Path>(obj), std::get<Intf>(obj),
-                        std::get<Prop>(obj), itProp->second);
+        mgr.setProperty(std::get<Slot>(obj), *value);
         return true;
     }
 
@@ -96,26 +88,23 @@ struct Handlers
      * @brief Processes an interfaces removed signal and removes the interface
      * (including its properties) from the object cache on the manager
      *
-     * @param[in] msg - The sdbusplus signal message
+     * @param[in] msg - The decoded signal message
      * @param[in] obj - Object data associated with the signal
      * @param[in] mgr - Manager that stores the object cache
      */
-    static bool interfacesRemoved(message& msg, const SignalObject& obj,
+    static bool interfacesRemoved(SignalMessage& msg, const SignalObject& obj,
                                   Manager& mgr)
     {
-        sdbusplus::message::object_path op;
-        msg.read(op);
-        if (static_cast<const std::string&>(op) != std::get<Path>(obj))
+        const auto& removed = msg.interfacesRemoved();
+        if (removed.path != std::get<Path>(obj))
         {
             // Path name does not match object's path
             return false;
         }
 
-        std::vector<std::string> intfs;
-        msg.read(intfs);
-        auto itIntf =
-            std::find(intfs.begin(), intfs.end(), std::get<Intf>(obj));
-        if (itIntf == intfs.cend())
+        auto itIntf = std::find(removed.intfs.begin(), removed.intfs.end(),
+                                std::get<Intf>(obj));
+        if (itIntf == removed.intfs.cend())
         {
             // Object's interface not in list of interfaces removed
             return false;
@@ -129,28 +118,20 @@ struct Handlers
      * @brief Processes a name owner changed signal and updates the service's
      * owner state for all objects/interfaces associated in the cache
      *
-     * @param[in] msg - The sdbusplus signal message
+     * @param[in] msg - The decoded signal message
      * @param[in] mgr - Manager that stores the service's owner state
      */
-    static bool nameOwnerChanged(message& msg, const SignalObject&,
+    static bool nameOwnerChanged(SignalMessage& msg, const SignalObject&,
                                  Manager& mgr)
     {
-        bool hasOwner = false;
-
-        std::string serv;
-        msg.read(serv);
-
-        std::string oldOwner;
-        msg.read(oldOwner);
-
-        std::string newOwner;
-        msg.read(newOwner);
-        if (!newOwner.empty())
+        const auto& owner = msg.nameOwnerChanged();
+        if (owner.name.empty())
         {
-            hasOwner = true;
+            // Service name could not be read from the signal
+            return false;
         }
 
-        mgr.setOwner(serv, hasOwner);
+        mgr.setOwner(owner.name, !owner.newOwner.empty());
         return true;
     }
 
@@ -158,7 +139,7 @@ struct Handlers
      * @brief Processes a dbus member signal, there is nothing associated or
      * any cache to update when this signal is received
      */
-    static bool member(message&, const SignalObject&, Manager&)
+    static bool member(SignalMessage&, const SignalObject&, Manager&)
     {
         return true;
     }
@@ -39,7 +39,8 @@ namespace phosphor::fan::control::json::trigger::init
 using json = nlohmann::json;
 using namespace phosphor::logging;
 
-void getProperties(Manager* mgr, const Group& group)
+void getProperties(Manager* mgr, const Group& group,
+                   const std::shared_ptr<AsyncLoad>& load)
 {
     for (const auto& member : group.getMembers())
     {
@@ -52,7 +53,7 @@ void getProperties(Manager* mgr, const Group& group)
             {
                 // Property not in cache, attempt to add it
                 mgr->addObjects(member, group.getInterface(),
-                                group.getProperty());
+                                group.getProperty(), load);
             }
         }
         catch (const util::DBusMethodError& dme)
@@ -64,7 +65,8 @@ void getProperties(Manager* mgr, const Group& group)
     }
 }
 
-void nameHasOwner(Manager* mgr, const Group& group)
+void nameHasOwner(Manager* mgr, const Group& group,
+                  const std::shared_ptr<AsyncLoad>&)
 {
     bool hasOwner = false;
     std::string lastName = "";
@@ -163,16 +165,22 @@ enableTrigger triggerInit(const json& jsonObj, const std::string& eventName,
             throw std::runtime_error(msg.c_str());
         }
 
+        Profiler::Scope profile{Profiler::instance().getID(
+            Profiler::triggers, "init:" + eventName)};
+
+        // Run each action after initializing all the groups
+        auto load = mgr->startLoad([&actions = actions]() {
+            for (auto& action : actions)
+            {
+                action->run();
+            }
+        });
         for (const auto& group : groups)
         {
             // Call method handler for each group to populate cache
-            handler->second(mgr, group);
-        }
-        for (auto& action : actions)
-        {
-            // Run each action after initializing all the groups
-            action->run();
+            handler->second(mgr, group, load);
         }
+        mgr->endLoad(load);
     };
 }
 
@@ -35,21 +35,28 @@ using json = nlohmann::json;
 /**
  * @brief An init method to get properties used in an event
  *
+ * The properties not already cached are requested asynchronously.
+ *
  * @param[in] mgr - Pointer to manager of the event
  * @param[in] group - Group associated with the event
+ * @param[in] load - Load the event's actions wait on before running
  */
-void getProperties(Manager* mgr, const Group& group);
+void getProperties(Manager* mgr, const Group& group,
+                   const std::shared_ptr<AsyncLoad>& load);
 
 /**
  * @brief An init method to get the owner name of a service used in an event
  *
  * @param[in] mgr - Pointer to manager of the event
  * @param[in] group - Group associated with the event
+ * @param[in] load - Load the event's actions wait on before running
  */
-void nameHasOwner(Manager* mgr, const Group& group);
+void nameHasOwner(Manager* mgr, const Group& group,
+                  const std::shared_ptr<AsyncLoad>& load);
 
 // Handler function for method calls
-using methodHandler = std::function<void(Manager*, const Group&)>;
+using methodHandler = std::function<void(Manager*, const Group&,
+                                         const std::shared_ptr<AsyncLoad>&)>;
 
 /* Supported methods to their corresponding handler functions */
 static const std::map<std::string, methodHandler> methods = {
@@ -42,16 +42,16 @@ using json = nlohmann::json;
 using namespace phosphor::logging;
 using namespace sdbusplus::bus::match;
 
-void subscribe(const std::string& match, SignalPkg&& signalPkg,
-               std::function<bool(SignalPkg&)> isSameSig, Manager* mgr)
+void subscribe(const std::string& match, const std::string& path,
+               SignalPkg&& signalPkg, std::function<bool(SignalPkg&)> isSameSig,
+               Manager* mgr)
 {
     auto& signalData = mgr->getSignal(match);
     if (signalData.empty())
     {
         // Signal subscription doesnt exist, add signal package and subscribe
-        std::unique_ptr<std::vector<SignalPkg>> pkgs =
-            std::make_unique<std::vector<SignalPkg>>();
-        pkgs->emplace_back(std::move(signalPkg));
+        std::unique_ptr<SignalPkgs> pkgs = std::make_unique<SignalPkgs>();
+        (*pkgs)[path].emplace_back(std::move(signalPkg));
         std::unique_ptr<sdbusplus::bus::match_t> ptrMatch = nullptr;
         if (!match.empty())
         {
@@ -59,7 +59,9 @@ void subscribe(const std::string& match, SignalPkg&& signalPkg,
             ptrMatch = std::make_unique<sdbusplus::bus::match_t>(
                 mgr->getBus(), match.c_str(),
                 std::bind(std::mem_fn(&Manager::handleSignal), &(*mgr),
-                          std::placeholders::_1, pkgs.get()));
+                          std::placeholders::_1, pkgs.get(),
+                          Profiler::instance().getID(Profiler::triggers,
+                                                     "signal:" + match)));
         }
         signalData.emplace_back(std::move(pkgs), std::move(ptrMatch));
     }
@@ -67,10 +69,10 @@ void subscribe(const std::string& match, SignalPkg&& signalPkg,
     {
         // Signal subscription already exists
         // Only a single signal data entry tied to each match is supported
-        auto& pkgs = std::get<std::unique_ptr<std::vector<SignalPkg>>>(
-            signalData.front());
+        auto& pkgs =
+            (*std::get<std::unique_ptr<SignalPkgs>>(signalData.front()))[path];
         auto sameSignal = false;
-        for (auto& pkg : *pkgs)
+        for (auto& pkg : pkgs)
         {
             if (isSameSig(pkg))
             {
@@ -87,57 +89,117 @@ void subscribe(const std::string& match, SignalPkg&& signalPkg,
         if (!sameSignal)
         {
             // Expected signal differs, add signal package
-            pkgs->emplace_back(std::move(signalPkg));
+            pkgs.emplace_back(std::move(signalPkg));
         }
     }
 }
 
+std::string getNamespace(const std::vector<std::string>& members)
+{
+    std::string ns;
+    for (auto it = members.begin(); it != members.end(); ++it)
+    {
+        auto parent = it->substr(0, it->find_last_of('/'));
+        if (it == members.begin())
+        {
+            ns = std::move(parent);
+            continue;
+        }
+        // Drop path elements until the namespace contains the parent
+        while (!ns.empty() && parent != ns &&
+               parent.compare(0, ns.size() + 1, ns + "/") != 0)
+        {
+            ns.erase(ns.find_last_of('/'));
+        }
+    }
+    return ns.empty() ? "/" : ns;
+}
+
 void propertiesChanged(Manager* mgr, const Group& group,
                        TriggerActions& actions, const json&)
 {
     // Groups are optional, but a signal triggered event with no groups
     // will do nothing since signals require a group
-    for (const auto& member : group.getMembers())
+    const auto& members = group.getMembers();
+    const auto& slots = group.getSlots();
+    if (members.empty())
+    {
+        return;
+    }
+
+    // A single match on the group's interface within the namespace of all
+    // the group members, with signals demultiplexed to each member by path
+    auto match =
+        rules::propertiesChanged(members.front(), group.getInterface());
+    if (members.size() > 1)
     {
+        const auto ns = getNamespace(members);
+        match = rules::type::signal() +
+                (ns != "/" ? rules::path_namespace(ns) : "") +
+                rules::interface("org.freedesktop.DBus.Properties") +
+                rules::member("PropertiesChanged") +
+                rules::argN(0, group.getInterface());
+    }
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        const auto& member = members[i];
         // Setup property changed signal handler on the group member's
         // property
-        const auto match =
-            rules::propertiesChanged(member, group.getInterface());
         SignalPkg signalPkg = {Handlers::propertiesChanged,
                                SignalObject(std::cref(member),
                                             std::cref(group.getInterface()),
-                                            std::cref(group.getProperty())),
+                                            std::cref(group.getProperty()),
+                                            slots[i]),
                                actions};
         auto isSameSig = [&prop = group.getProperty()](SignalPkg& pkg) {
             auto& obj = std::get<SignalObject>(pkg);
             return prop == std::get<Prop>(obj);
         };
 
-        subscribe(match, std::move(signalPkg), isSameSig, mgr);
+        subscribe(match, member, std::move(signalPkg), isSameSig, mgr);
     }
 }
 
+std::string argPathRule(const std::vector<std::string>& members)
+{
+    if (members.size() == 1)
+    {
+        return rules::argNpath(0, members.front());
+    }
+    // A trailing '/' matches every path within the namespace
+    const auto ns = getNamespace(members);
+    return rules::argNpath(0, ns != "/" ? ns + "/" : ns);
+}
+
 void interfacesAdded(Manager* mgr, const Group& group, TriggerActions& actions,
                      const json&)
 {
     // Groups are optional, but a signal triggered event with no groups
     // will do nothing since signals require a group
-    for (const auto& member : group.getMembers())
+    const auto& members = group.getMembers();
+    const auto& slots = group.getSlots();
+    if (members.empty())
     {
-        // Setup interfaces added signal handler on the group member
-        const auto match =
-            rules::interfacesAdded() + rules::argNpath(0, member);
+        return;
+    }
+
+    // Setup interfaces added signal handler on the group members
+    const auto match = rules::interfacesAdded() + argPathRule(members);
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        const auto& member = members[i];
         SignalPkg signalPkg = {Handlers::interfacesAdded,
                                SignalObject(std::cref(member),
                                             std::cref(group.getInterface()),
-                                            std::cref(group.getProperty())),
+                                            std::cref(group.getProperty()),
+                                            slots[i]),
                                actions};
         auto isSameSig = [&intf = group.getInterface()](SignalPkg& pkg) {
             auto& obj = std::get<SignalObject>(pkg);
             return intf == std::get<Intf>(obj);
         };
 
-        subscribe(match, std::move(signalPkg), isSameSig, mgr);
+        subscribe(match, member, std::move(signalPkg), isSameSig, mgr);
     }
 }
 
@@ -146,21 +208,30 @@ void interfacesRemoved(Manager* mgr, const Group& group,
 {
     // Groups are optional, but a signal triggered event with no groups
     // will do nothing since signals require a group
-    for (const auto& member : group.getMembers())
+    const auto& members = group.getMembers();
+    const auto& slots = group.getSlots();
+    if (members.empty())
+    {
+        return;
+    }
+
+    // Setup interfaces removed signal handler on the group members
+    const auto match = rules::interfacesRemoved() + argPathRule(members);
+    for (size_t i = 0; i < members.size(); i++)
     {
-        // Setup interfaces added signal handler on the group member
-        const auto match = rules::interfacesRemoved(member);
+        const auto& member = members[i];
         SignalPkg signalPkg = {Handlers::interfacesRemoved,
                                SignalObject(std::cref(member),
                                             std::cref(group.getInterface()),
-                                            std::cref(group.getProperty())),
+                                            std::cref(group.getProperty()),
+                                            slots[i]),
                                actions};
         auto isSameSig = [&intf = group.getInterface()](SignalPkg& pkg) {
             auto& obj = std::get<SignalObject>(pkg);
             return intf == std::get<Intf>(obj);
         };
 
-        subscribe(match, std::move(signalPkg), isSameSig, mgr);
+        subscribe(match, member, std::move(signalPkg), isSameSig, mgr);
     }
 }
 
@@ -194,7 +265,7 @@ void nameOwnerChanged(Manager* mgr, const Group& group, TriggerActions& actions,
                 // same so add action to be run
                 auto isSameSig = [](SignalPkg& pkg) { return true; };
 
-                subscribe(match, std::move(signalPkg), isSameSig, mgr);
+                subscribe(match, "", std::move(signalPkg), isSameSig, mgr);
                 grpServices.emplace_back(serv);
             }
         }
@@ -216,8 +287,6 @@ void nameOwnerChanged(Manager* mgr, const Group& group, TriggerActions& actions,
 void member(Manager* mgr, const Group& group, TriggerActions& actions,
             const json&)
 {
-    // No SignalObject required to associate to this signal
-    SignalPkg signalPkg = {Handlers::member, SignalObject(), actions};
     // If signal match already exists, then the member signal will be the
     // same so add action to be run
     auto isSameSig = [](SignalPkg& pkg) { return true; };
@@ -226,12 +295,14 @@ void member(Manager* mgr, const Group& group, TriggerActions& actions,
     // will do nothing since signals require a group
     for (const auto& member : group.getMembers())
     {
+        // No SignalObject required to associate to this signal
+        SignalPkg signalPkg = {Handlers::member, SignalObject(), actions};
         // Subscribe for signal from each group member
         const auto match =
             rules::type::signal() + rules::member(group.getProperty()) +
             rules::path(member) + rules::interface(group.getInterface());
 
-        subscribe(match, std::move(signalPkg), isSameSig, mgr);
+        subscribe(match, member, std::move(signalPkg), isSameSig, mgr);
     }
 }
 
@@ -261,10 +332,18 @@ enableTrigger triggerSignal(const json& jsonObj, const std::string& eventName,
         throw std::runtime_error(msg.c_str());
     }
 
-    return [subscriber = std::move(subscriber),
-            jsonObj](const std::string& eventName, Manager* mgr,
-                     const std::vector<Group>& groups,
-                     std::vector<std::unique_ptr<ActionBase>>& actions) {
+    // Coalescing the actions run by the signal is optional
+    auto coalesce = jsonObj.contains("coalesce_actions") &&
+                    jsonObj["coalesce_actions"].get<bool>();
+
+    return [subscriber = std::move(subscriber), jsonObj,
+            coalesce](const std::string& eventName, Manager* mgr,
+                      const std::vector<Group>& groups,
+                      std::vector<std::unique_ptr<ActionBase>>& actions) {
+        if (coalesce)
+        {
+            mgr->coalesceActions(actions);
+        }
         TriggerActions signalActions;
         std::for_each(actions.begin(), actions.end(),
                       [&signalActions](auto& action) {
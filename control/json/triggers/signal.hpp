@@ -35,13 +35,39 @@ using json = nlohmann::json;
 /**
  * @brief Subscribe to a signal
  *
+ * Multiple objects can share a single match, a received signal is only
+ * handled by the packages attached for the object path the signal is about.
+ *
  * @param[in] match - Signal match string to subscribe to
+ * @param[in] path - Object path the package is for, empty when the signal is
+ *                   not about a specific object path
  * @param[in] pkg - Data package to attach to signal
  * @param[in] isSameSig - Function to determine if same signal being subscribed
  * @param[in] mgr - Pointer to manager of the trigger
  */
-void subscribe(const std::string& match, SignalPkg&& pkg,
-               std::function<bool(SignalPkg&)> isSameSig, Manager* mgr);
+void subscribe(const std::string& match, const std::string& path,
+               SignalPkg&& pkg, std::function<bool(SignalPkg&)> isSameSig,
+               Manager* mgr);
+
+/**
+ * @brief Get the deepest path namespace containing the parents of all
+ * the given object paths
+ *
+ * @param[in] members - List of object paths
+ *
+ * @return - The namespace, "/" when the paths share no common ancestor
+ */
+std::string getNamespace(const std::vector<std::string>& members);
+
+/**
+ * @brief Get the arg0path rule matching the object path argument of
+ * interfacesAdded/interfacesRemoved signals for all the given object paths
+ *
+ * @param[in] members - List of object paths
+ *
+ * @return - The match rule
+ */
+std::string argPathRule(const std::vector<std::string>& members);
 
 /**
  * @brief Subscribes to a propertiesChanged signal
@@ -115,6 +141,11 @@ static const std::unordered_map<std::string, SignalMatch> signals = {
  * When fan control starts (or restarts), all events with 'signal' triggers are
  * subscribed to run its corresponding actions when a signal, per its
  * configuration, is received.
+ *
+ * A signal trigger configured with "coalesce_actions" set to true only marks
+ * its actions to be run when a signal is received, and each marked action is
+ * run once at the end of that event loop iteration. This saves rerunning the
+ * actions for every signal in a burst of signals, i.e. sensor updates.
  */
 enableTrigger triggerSignal(const json& jsonObj, const std::string& eventName,
                             std::vector<std::unique_ptr<ActionBase>>& actions);
@@ -81,6 +81,13 @@ bool getPreload(const json& jsonObj)
     return false;
 }
 
+bool getTrackObjects(const json& jsonObj)
+{
+    // Keeping preloaded groups current with signals is optional
+    return jsonObj.contains("track_objects") &&
+           jsonObj["track_objects"].get<bool>();
+}
+
 enableTrigger triggerTimer(const json& jsonObj, const std::string& eventName,
                            std::vector<std::unique_ptr<ActionBase>>& actions)
 {
@@ -88,14 +95,15 @@ enableTrigger triggerTimer(const json& jsonObj, const std::string& eventName,
     auto type = getType(jsonObj);
     auto interval = getInterval(jsonObj);
     auto preload = getPreload(jsonObj);
+    auto track = getTrackObjects(jsonObj);
 
     return [type = std::move(type), interval = std::move(interval),
-            preload = std::move(preload)](
+            preload = std::move(preload), track = std::move(track)](
                const std::string& eventName, Manager* mgr,
                const std::vector<Group>& groups,
                std::vector<std::unique_ptr<ActionBase>>& actions) {
-        auto tpPtr = std::make_unique<TimerPkg>(eventName, std::ref(actions),
-                                                std::cref(groups), preload);
+        auto tpPtr = std::make_unique<TimerPkg>(
+            eventName, std::ref(actions), std::cref(groups), preload, track);
         mgr->addTimer(type, interval, std::move(tpPtr));
     };
 }
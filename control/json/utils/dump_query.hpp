@@ -0,0 +1,161 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+/**
+ * A query of a section of the fan control debug dump, answered either from
+ * the dump file or by fan control itself over its query socket.
+ */
+struct DumpQuery
+{
+    /* The dump section name */
+    std::string section;
+
+    /* Optional substring of the names of the section's entries to match */
+    std::string name;
+
+    /* Optional names of the properties of the entries to get */
+    std::vector<std::string> properties;
+
+    /**
+     * @brief Returns the query as a JSON request
+     */
+    json toJson() const
+    {
+        return json{
+            {"section", section}, {"name", name}, {"properties", properties}};
+    }
+
+    /**
+     * @brief Returns a query from a JSON request
+     *
+     * @param[in] request - The JSON request
+     *
+     * @throws - nlohmann::json::exception when the request is invalid
+     */
+    static DumpQuery fromJson(const json& request)
+    {
+        DumpQuery dq;
+        dq.section = request.at("section").get<std::string>();
+        if (request.contains("name"))
+        {
+            dq.name = request["name"].get<std::string>();
+        }
+        if (request.contains("properties"))
+        {
+            dq.properties =
+                request["properties"].get<std::vector<std::string>>();
+        }
+        return dq;
+    }
+
+    /**
+     * @brief Returns if an entry name matches the query
+     *
+     * @param[in] entry - The entry name
+     */
+    bool matchesName(const std::string& entry) const
+    {
+        return name.empty() || (entry.find(name) != std::string::npos);
+    }
+
+    /**
+     * @brief Returns if a property is one of the query's properties
+     *
+     * @param[in] prop - The property name
+     */
+    bool hasProperty(const std::string& prop) const
+    {
+        return std::find(properties.begin(), properties.end(), prop) !=
+               properties.end();
+    }
+
+    /**
+     * @brief Get the entries of a dump section matching the query
+     *
+     * The string entries of an array section are matched by name. The
+     * entries of an object section are matched by key and, when properties
+     * are given, reduced to those properties found one or two levels down.
+     *
+     * @param[in] section - The dump section's JSON
+     *
+     * @return - The matching entries
+     */
+    json filter(const json& section) const
+    {
+        json output;
+
+        if (section.is_array())
+        {
+            for (const auto& entry : section)
+            {
+                if (!entry.is_string() ||
+                    matchesName(entry.get<std::string>()))
+                {
+                    output[this->section].push_back(entry);
+                }
+            }
+            return output;
+        }
+
+        for (const auto& [key1, values1] : section.items())
+        {
+            if (!matchesName(key1))
+            {
+                continue;
+            }
+
+            // If no properties specified, get the whole JSON value
+            if (properties.empty())
+            {
+                output[key1] = values1;
+                continue;
+            }
+
+            // Look for properties both one and two levels down.
+            // Future improvement: Use recursion.
+            for (const auto& [key2, values2] : values1.items())
+            {
+                if (hasProperty(key2))
+                {
+                    output[key1][key2] = values2;
+                }
+
+                for (const auto& [key3, values3] : values2.items())
+                {
+                    if (hasProperty(key3))
+                    {
+                        output[key1][key3] = values3;
+                    }
+                }
+            }
+        }
+        return output;
+    }
+};
+
+} // namespace phosphor::fan::control::json
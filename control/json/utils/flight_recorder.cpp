@@ -15,18 +15,15 @@
  */
 #include "flight_recorder.hpp"
 
+#include <fmt/args.h>
 #include <fmt/format.h>
 
 #include <phosphor-logging/log.hpp>
 
 #include <algorithm>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <tuple>
 #include <vector>
 
-constexpr auto maxEntriesPerID = 20;
-
 namespace phosphor::fan::control::json
 {
 using json = nlohmann::json;
@@ -37,18 +34,85 @@ FlightRecorder& FlightRecorder::instance()
     return fr;
 }
 
-void FlightRecorder::log(const std::string& id, const std::string& message)
+FlightRecorder::ID FlightRecorder::getID(const std::string& id)
+{
+    auto [it, added] = _ids.emplace(id, _rings.size());
+    if (added)
+    {
+        _rings.emplace_back().name = id;
+    }
+    return it->second;
+}
+
+void FlightRecorder::persistTo(const std::string& path)
+{
+    _file = std::make_unique<FlightRecorderFile>(path);
+}
+
+FlightRecorder::Entry& FlightRecorder::nextEntry(ID id)
+{
+    auto& ring = _rings.at(id);
+    if (ring.entries.empty())
+    {
+        ring.entries.resize(maxEntriesPerID);
+    }
+
+    auto& entry = ring.entries[ring.next];
+    ring.next = (ring.next + 1) % maxEntriesPerID;
+    ring.size = std::min(ring.size + 1, maxEntriesPerID);
+
+    entry.timestamp =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    return entry;
+}
+
+void FlightRecorder::writeToFile(ID id, const Entry& entry)
 {
-    uint64_t ts = std::chrono::duration_cast<std::chrono::microseconds>(
-                      std::chrono::system_clock::now().time_since_epoch())
-                      .count();
+    using Type = FlightRecorderFile::Arg::Type;
 
-    auto& entry = _entries[id];
-    entry.emplace_back(ts, message);
-    if (entry.size() > maxEntriesPerID)
+    auto& record =
+        _file->begin(_rings[id].name, entry.format, entry.timestamp);
+    for (size_t i = 0; i < entry.numArgs; i++)
     {
-        entry.pop_front();
+        auto& arg = record.args[i];
+        std::visit(
+            [&arg](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, bool>)
+                {
+                    arg.type = Type::boolean;
+                    arg.value.b = value;
+                }
+                else if constexpr (std::is_same_v<T, int64_t>)
+                {
+                    arg.type = Type::int64;
+                    arg.value.i = value;
+                }
+                else if constexpr (std::is_same_v<T, uint64_t>)
+                {
+                    arg.type = Type::uint64;
+                    arg.value.u = value;
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    arg.type = Type::float64;
+                    arg.value.d = value;
+                }
+                else if constexpr (std::is_same_v<T, std::string>)
+                {
+                    FlightRecorderFile::setString(arg, value);
+                }
+                else
+                {
+                    arg.type = Type::none;
+                }
+            },
+            entry.args[i]);
     }
+    record.numArgs = entry.numArgs;
+    _file->end(record);
 }
 
 void FlightRecorder::dump(json& data)
@@ -57,43 +121,70 @@ void FlightRecorder::dump(json& data)
     using Timepoint = time_point<system_clock, microseconds>;
 
     size_t idSize = 0;
-    std::vector<std::tuple<Timepoint, std::string, std::string>> output;
+    std::vector<std::tuple<Timepoint, const std::string*, const Entry*>>
+        output;
 
-    for (const auto& [id, messages] : _entries)
+    for (const auto& ring : _rings)
     {
-        for (const auto& [ts, msg] : messages)
+        if (ring.size != 0)
         {
-            idSize = std::max(idSize, id.size());
-            Timepoint tp{microseconds{ts}};
-            output.emplace_back(tp, id, msg);
+            idSize = std::max(idSize, ring.name.size());
+        }
+        // Oldest message first
+        auto first = ring.next + maxEntriesPerID - ring.size;
+        for (size_t i = 0; i < ring.size; i++)
+        {
+            const auto& entry =
+                ring.entries[(first + i) % maxEntriesPerID];
+            Timepoint tp{microseconds{entry.timestamp}};
+            output.emplace_back(tp, &ring.name, &entry);
         }
     }
 
-    std::sort(output.begin(), output.end(),
-              [](const auto& left, const auto& right) {
-                  return std::get<Timepoint>(left) < std::get<Timepoint>(right);
-              });
-
-    auto formatTime = [](const Timepoint& tp) {
-        std::stringstream ss;
-        std::time_t tt = system_clock::to_time_t(tp);
-        uint64_t us =
-            duration_cast<microseconds>(tp.time_since_epoch()).count();
-
-        // e.g. Oct 04 16:43:45.923555
-        ss << std::put_time(std::localtime(&tt), "%b %d %H:%M:%S.");
-        ss << std::setfill('0') << std::setw(6) << std::to_string(us % 1000000);
-        return ss.str();
+    std::stable_sort(output.begin(), output.end(),
+                     [](const auto& left, const auto& right) {
+                         return std::get<Timepoint>(left) <
+                                std::get<Timepoint>(right);
+                     });
+
+    auto formatMessage = [](const Entry& entry) {
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        for (size_t i = 0; i < entry.numArgs; i++)
+        {
+            std::visit(
+                [&args](const auto& arg) {
+                    using Type = std::decay_t<decltype(arg)>;
+                    if constexpr (std::is_same_v<Type, std::monostate>)
+                    {
+                        args.push_back("");
+                    }
+                    else if constexpr (std::is_same_v<Type, std::string>)
+                    {
+                        args.push_back(std::cref(arg));
+                    }
+                    else
+                    {
+                        args.push_back(arg);
+                    }
+                },
+                entry.args[i]);
+        }
+        try
+        {
+            return fmt::vformat(entry.format, args);
+        }
+        catch (const fmt::format_error&)
+        {
+            return std::string{entry.format};
+        }
     };
 
     auto& fr = data["flight_recorder"];
-    std::stringstream ss;
-
-    for (const auto& [ts, id, msg] : output)
+    for (const auto& [ts, id, entry] : output)
     {
-        ss << formatTime(ts) << ": " << std::setw(idSize) << id << ": " << msg;
-        fr.push_back(ss.str());
-        ss.str("");
+        fr.push_back(FlightRecorderFile::formatLine(
+            ts.time_since_epoch().count(), *id, idSize,
+            formatMessage(*entry)));
     }
 }
 
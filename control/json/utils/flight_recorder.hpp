@@ -14,14 +14,20 @@
  * limitations under the License.
  */
 #pragma once
+#include "flight_recorder_file.hpp"
+
 #include <nlohmann/json.hpp>
 
+#include <array>
 #include <chrono>
 #include <cstdint>
-#include <deque>
+#include <memory>
 #include <string>
-#include <tuple>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <variant>
+#include <vector>
 
 namespace phosphor::fan::control::json
 {
@@ -34,6 +40,15 @@ using json = nlohmann::json;
  * When an ID accumulates so many messages, the oldest one will
  * be removed when a new one is added.
  *
+ * IDs are interned to a number so callers logging often can look theirs up
+ * once. Each ID's messages are kept in a fixed size ring of entries that
+ * is allocated the first time the ID logs, and a message is stored as its
+ * format string and arguments, so logging doesn't format or allocate.
+ * The messages are only formatted when they are dumped.
+ *
+ * The messages can also be kept in a FlightRecorderFile, so they outlive
+ * the process if it crashes or is killed.
+ *
  * The dump() function interleaves the messages for all IDs together
  * based on timestamp and then writes them all to /tmp/fan_control.txt.
  *
@@ -44,6 +59,15 @@ using json = nlohmann::json;
 class FlightRecorder
 {
   public:
+    /* Interned ID of a message owner */
+    using ID = size_t;
+
+    /* Number of messages kept per ID */
+    static constexpr size_t maxEntriesPerID = 20;
+
+    /* Maximum number of arguments of a message */
+    static constexpr size_t maxArgs = FlightRecorderFile::maxArgs;
+
     ~FlightRecorder() = default;
     FlightRecorder(const FlightRecorder&) = delete;
     FlightRecorder& operator=(const FlightRecorder&) = delete;
@@ -55,13 +79,76 @@ class FlightRecorder
      */
     static FlightRecorder& instance();
 
+    /**
+     * @brief Get the interned ID of a message owner, interning it if needed
+     *
+     * @param[in] id - The ID of the message owner
+     *
+     * @return - The interned ID
+     */
+    ID getID(const std::string& id);
+
+    /**
+     * @brief Also keep the messages logged from now on in a memory mapped
+     *        file that is kept if the process crashes or is killed
+     *
+     * @param[in] path - Path of the file
+     *
+     * @throws std::runtime_error when the file fails to be mapped
+     */
+    void persistTo(const std::string& path);
+
+    /**
+     * @brief Logs an entry to the recorder.
+     *
+     * Only the pointer to the format string is kept, so it must be a string
+     * literal. The arguments are copied and formatted with it on a dump.
+     *
+     * @param[in] id - The interned ID of the message owner
+     * @param[in] format - The fmt format string of the message
+     * @param[in] args - The arguments of the message
+     */
+    template <typename... Args>
+    void log(ID id, const char* format, Args&&... args)
+    {
+        static_assert(sizeof...(Args) <= maxArgs,
+                      "Too many flight recorder message arguments");
+
+        auto& entry = nextEntry(id);
+        entry.format = format;
+        entry.numArgs = sizeof...(Args);
+        [[maybe_unused]] size_t i = 0;
+        (setArg(entry.args[i++], std::forward<Args>(args)), ...);
+
+        if (_file)
+        {
+            writeToFile(id, entry);
+        }
+    }
+
+    /**
+     * @brief Logs an entry to the recorder.
+     *
+     * @param[in] id - The ID of the message owner
+     * @param[in] format - The fmt format string literal of the message
+     * @param[in] args - The arguments of the message
+     */
+    template <typename... Args>
+    void log(const std::string& id, const char* format, Args&&... args)
+    {
+        log(getID(id), format, std::forward<Args>(args)...);
+    }
+
     /**
      * @brief Logs an entry to the recorder.
      *
      * @param[in] id - The ID of the message owner
      * @param[in] message - The message to log
      */
-    void log(const std::string& id, const std::string& message);
+    void log(const std::string& id, const std::string& message)
+    {
+        log(getID(id), "{}", message);
+    }
 
     /**
      * @brief Writes the flight recorder contents to JSON.
@@ -75,11 +162,97 @@ class FlightRecorder
   private:
     FlightRecorder() = default;
 
-    // tuple<timestamp, message>
-    using Entry = std::tuple<uint64_t, std::string>;
+    /* A message argument */
+    using Arg = std::variant<std::monostate, bool, int64_t, uint64_t, double,
+                             std::string>;
+
+    /* A message, formatted when dumped */
+    struct Entry
+    {
+        uint64_t timestamp = 0;
+        const char* format = nullptr;
+        uint8_t numArgs = 0;
+        std::array<Arg, maxArgs> args;
+    };
+
+    /* The messages of an ID */
+    struct Ring
+    {
+        std::string name;
+        std::vector<Entry> entries;
+        size_t next = 0;
+        size_t size = 0;
+    };
+
+    /**
+     * @brief Get the entry to store an ID's next message in, replacing its
+     *        oldest message when its ring is full
+     *
+     * @param[in] id - The interned ID of the message owner
+     *
+     * @return - The timestamped entry
+     */
+    Entry& nextEntry(ID id);
+
+    /**
+     * @brief Append a message to the persistent file
+     *
+     * @param[in] id - The interned ID of the message owner
+     * @param[in] entry - The message
+     */
+    void writeToFile(ID id, const Entry& entry);
+
+    /**
+     * @brief Store a message argument
+     *
+     * Strings are assigned to an entry's existing string, so once the ring
+     * wrapped they reuse the memory of the argument they replace.
+     *
+     * @param[out] arg - The stored argument
+     * @param[in] value - The argument's value
+     */
+    template <typename T>
+    static void setArg(Arg& arg, T&& value)
+    {
+        using Type = std::decay_t<T>;
+        if constexpr (std::is_same_v<Type, bool>)
+        {
+            arg = value;
+        }
+        else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+        {
+            arg = static_cast<int64_t>(value);
+        }
+        else if constexpr (std::is_integral_v<Type>)
+        {
+            arg = static_cast<uint64_t>(value);
+        }
+        else if constexpr (std::is_floating_point_v<Type>)
+        {
+            arg = static_cast<double>(value);
+        }
+        else
+        {
+            std::string_view str{value};
+            if (auto* current = std::get_if<std::string>(&arg))
+            {
+                current->assign(str);
+            }
+            else
+            {
+                arg.emplace<std::string>(str);
+            }
+        }
+    }
+
+    /* The interned IDs */
+    std::unordered_map<std::string, ID> _ids;
+
+    /* The messages indexed by interned ID */
+    std::vector<Ring> _rings;
 
-    /* The messages */
-    std::unordered_map<std::string, std::deque<Entry>> _entries;
+    /* Optional file the messages are also kept in */
+    std::unique_ptr<FlightRecorderFile> _file;
 };
 
 } // namespace phosphor::fan::control::json
@@ -0,0 +1,428 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * @class FlightRecorderFile
+ *
+ * A ring of flight recorder messages kept in a memory mapped file, so the
+ * messages logged before fan control crashed or was killed can still be
+ * read afterwards, i.e. by `fanctl flight_recorder`.
+ *
+ * Appending a message only copies it into the mapped ring, no system calls
+ * are made. A message is stored as its owner's ID, its format string, and
+ * its arguments, with strings truncated to fit the fixed size records, and
+ * is only formatted when the file is decoded.
+ *
+ * The ring is continued when an existing file of the same layout is
+ * opened, so the messages of the previous run are kept until overwritten.
+ */
+class FlightRecorderFile
+{
+  public:
+    /* Number of messages kept in the ring */
+    static constexpr uint32_t numRecords = 512;
+
+    /* Maximum number of arguments of a message */
+    static constexpr size_t maxArgs = 4;
+
+    /* Sizes of the strings of a message, including their terminator */
+    static constexpr size_t idSize = 32;
+    static constexpr size_t formatSize = 96;
+    static constexpr size_t strSize = 32;
+
+    /* A message argument */
+    struct Arg
+    {
+        enum class Type : uint8_t
+        {
+            none,
+            boolean,
+            int64,
+            uint64,
+            float64,
+            string
+        };
+
+        Type type;
+        union
+        {
+            bool b;
+            int64_t i;
+            uint64_t u;
+            double d;
+            char s[strSize];
+        } value;
+    };
+
+    /* A message */
+    struct Record
+    {
+        /* Sequence number of the message, 0 while it's being written */
+        std::atomic<uint64_t> seq;
+        uint64_t timestamp;
+        char id[idSize];
+        char format[formatSize];
+        uint8_t numArgs;
+        Arg args[maxArgs];
+    };
+
+    FlightRecorderFile() = delete;
+    FlightRecorderFile(const FlightRecorderFile&) = delete;
+    FlightRecorderFile& operator=(const FlightRecorderFile&) = delete;
+    FlightRecorderFile(FlightRecorderFile&&) = delete;
+    FlightRecorderFile& operator=(FlightRecorderFile&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * Maps the file, creating it or resetting it when its layout differs.
+     *
+     * @param[in] path - Path of the file
+     *
+     * @throws std::runtime_error when the file fails to be mapped
+     */
+    explicit FlightRecorderFile(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error{fmt::format(
+                "Failed opening {}: {}", path, std::strerror(errno))};
+        }
+
+        struct stat st;
+        bool reset = (fstat(fd, &st) != 0) ||
+                     (static_cast<size_t>(st.st_size) != fileSize);
+        if (reset && (ftruncate(fd, fileSize) != 0))
+        {
+            auto err = errno;
+            close(fd);
+            throw std::runtime_error{
+                fmt::format("Failed sizing {}: {}", path, std::strerror(err))};
+        }
+
+        auto* addr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+        auto err = errno;
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            throw std::runtime_error{
+                fmt::format("Failed mapping {}: {}", path, std::strerror(err))};
+        }
+
+        _header = static_cast<Header*>(addr);
+        _records = reinterpret_cast<Record*>(_header + 1);
+        if (reset || !_header->isValid())
+        {
+            std::memset(addr, 0, fileSize);
+            *_header = Header{};
+        }
+    }
+
+    ~FlightRecorderFile()
+    {
+        munmap(_header, fileSize);
+    }
+
+    /**
+     * @brief Start writing the next message, replacing the oldest one
+     *
+     * The message isn't read back until it's committed with end().
+     *
+     * @param[in] id - ID of the message owner
+     * @param[in] format - The fmt format string of the message
+     * @param[in] timestamp - Timestamp of the message in microseconds
+     *
+     * @return - The message's record to set the arguments of
+     */
+    Record& begin(std::string_view id, const char* format, uint64_t timestamp)
+    {
+        _seq = ++_header->seq;
+        auto& record = _records[_seq % numRecords];
+        record.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        record.timestamp = timestamp;
+        copy(record.id, id);
+        copy(record.format, format);
+        record.numArgs = 0;
+        return record;
+    }
+
+    /**
+     * @brief Commit the message started by begin()
+     *
+     * @param[in] record - The message's record
+     */
+    void end(Record& record)
+    {
+        record.seq.store(_seq, std::memory_order_release);
+    }
+
+    /**
+     * @brief Store a string argument of a message
+     *
+     * @param[out] arg - The argument
+     * @param[in] value - The argument's value
+     */
+    static void setString(Arg& arg, std::string_view value)
+    {
+        arg.type = Arg::Type::string;
+        copy(arg.value.s, value);
+    }
+
+    /**
+     * @brief Format a flight recorder line the same as a dump does
+     *
+     * @param[in] timestamp - Timestamp of the message in microseconds
+     * @param[in] id - ID of the message owner
+     * @param[in] idWidth - Width to right align the ID to
+     * @param[in] message - The message
+     *
+     * @return - The line, i.e.
+     * "Oct 01 04:37:19.122771:           main: Startup"
+     */
+    static std::string formatLine(uint64_t timestamp, std::string_view id,
+                                  size_t idWidth, std::string_view message)
+    {
+        using namespace std::chrono;
+        using Timepoint = time_point<system_clock, microseconds>;
+
+        std::stringstream ss;
+        Timepoint tp{microseconds{timestamp}};
+        std::time_t tt = system_clock::to_time_t(tp);
+
+        // e.g. Oct 04 16:43:45.923555
+        ss << std::put_time(std::localtime(&tt), "%b %d %H:%M:%S.");
+        ss << std::setfill('0') << std::setw(6)
+           << std::to_string(timestamp % 1000000);
+        ss << std::setfill(' ') << ": " << std::setw(idWidth) << id << ": "
+           << message;
+        return ss.str();
+    }
+
+    /**
+     * @brief Decode the messages of a file, oldest first
+     *
+     * @param[in] path - Path of the file
+     *
+     * @return - The formatted flight recorder lines
+     *
+     * @throws std::runtime_error when the file isn't a flight recorder file
+     */
+    static std::vector<std::string> decode(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error{fmt::format(
+                "Failed opening {}: {}", path, std::strerror(errno))};
+        }
+
+        struct stat st;
+        void* addr = MAP_FAILED;
+        if ((fstat(fd, &st) == 0) &&
+            (static_cast<size_t>(st.st_size) == fileSize))
+        {
+            addr = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            throw std::runtime_error{
+                fmt::format("{} is not a flight recorder file", path)};
+        }
+
+        const auto* header = static_cast<const Header*>(addr);
+        const auto* records = reinterpret_cast<const Record*>(header + 1);
+        if (!header->isValid())
+        {
+            munmap(addr, fileSize);
+            throw std::runtime_error{
+                fmt::format("{} is not a flight recorder file", path)};
+        }
+
+        // tuple<seq, timestamp, id, message>
+        std::vector<std::tuple<uint64_t, uint64_t, std::string, std::string>>
+            messages;
+        size_t idWidth = 0;
+        for (uint32_t i = 0; i < numRecords; i++)
+        {
+            // Skip messages being written while they're copied
+            auto seq = records[i].seq.load(std::memory_order_acquire);
+            if (seq == 0)
+            {
+                continue;
+            }
+            Record record;
+            std::memcpy(static_cast<void*>(&record), &records[i],
+                        sizeof(Record));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (records[i].seq.load(std::memory_order_relaxed) != seq)
+            {
+                continue;
+            }
+
+            std::string id{record.id, strnlen(record.id, idSize)};
+            idWidth = std::max(idWidth, id.size());
+            messages.emplace_back(seq, record.timestamp, std::move(id),
+                                  formatMessage(record));
+        }
+        munmap(addr, fileSize);
+
+        std::sort(messages.begin(), messages.end(),
+                  [](const auto& left, const auto& right) {
+                      return std::tie(std::get<1>(left), std::get<0>(left)) <
+                             std::tie(std::get<1>(right), std::get<0>(right));
+                  });
+
+        std::vector<std::string> lines;
+        for (const auto& [seq, timestamp, id, message] : messages)
+        {
+            lines.push_back(formatLine(timestamp, id, idWidth, message));
+        }
+        return lines;
+    }
+
+  private:
+    /* Start of the file */
+    struct Header
+    {
+        char magic[8] = {'F', 'A', 'N', 'C', 'T', 'L', 'F', 'R'};
+        uint32_t version = 1;
+        uint32_t numRecords = FlightRecorderFile::numRecords;
+        uint32_t recordSize = sizeof(Record);
+        uint32_t reserved = 0;
+        /* Sequence number of the last message */
+        uint64_t seq = 0;
+
+        /**
+         * @brief Returns if the header is of a file with the same layout
+         */
+        bool isValid() const
+        {
+            Header expected;
+            return (std::memcmp(magic, expected.magic, sizeof(magic)) == 0) &&
+                   (version == expected.version) &&
+                   (numRecords == expected.numRecords) &&
+                   (recordSize == expected.recordSize);
+        }
+    };
+
+    /* Size of the file */
+    static constexpr size_t fileSize =
+        sizeof(Header) + (numRecords * sizeof(Record));
+
+    /**
+     * @brief Copy a string into a fixed size buffer, truncating it to fit
+     *
+     * @param[out] dest - The buffer
+     * @param[in] src - The string
+     */
+    template <size_t N>
+    static void copy(char (&dest)[N], std::string_view src)
+    {
+        auto size = std::min(src.size(), N - 1);
+        std::memcpy(dest, src.data(), size);
+        dest[size] = '\0';
+    }
+
+    /**
+     * @brief Format a stored message
+     *
+     * @param[in] record - The message's record
+     *
+     * @return - The message
+     */
+    static std::string formatMessage(const Record& record)
+    {
+        std::string format{record.format, strnlen(record.format, formatSize)};
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        for (size_t i = 0; i < std::min<size_t>(record.numArgs, maxArgs); i++)
+        {
+            const auto& arg = record.args[i];
+            switch (arg.type)
+            {
+                case Arg::Type::boolean:
+                    args.push_back(arg.value.b);
+                    break;
+                case Arg::Type::int64:
+                    args.push_back(arg.value.i);
+                    break;
+                case Arg::Type::uint64:
+                    args.push_back(arg.value.u);
+                    break;
+                case Arg::Type::float64:
+                    args.push_back(arg.value.d);
+                    break;
+                case Arg::Type::string:
+                    args.push_back(std::string{
+                        arg.value.s, strnlen(arg.value.s, strSize)});
+                    break;
+                default:
+                    args.push_back("");
+                    break;
+            }
+        }
+        try
+        {
+            return fmt::vformat(format, args);
+        }
+        catch (const fmt::format_error&)
+        {
+            return format;
+        }
+    }
+
+    /* The mapped header */
+    Header* _header = nullptr;
+
+    /* The mapped ring of messages */
+    Record* _records = nullptr;
+
+    /* Sequence number of the message being written */
+    uint64_t _seq = 0;
+};
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,116 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "json_writer.hpp"
+
+#include <string>
+
+namespace phosphor::fan::control::json
+{
+
+constexpr size_t indentSize = 4;
+
+void JsonWriter::beginObject()
+{
+    begin('{');
+}
+
+void JsonWriter::endObject()
+{
+    end('}');
+}
+
+void JsonWriter::beginArray()
+{
+    begin('[');
+}
+
+void JsonWriter::endArray()
+{
+    end(']');
+}
+
+void JsonWriter::key(std::string_view name)
+{
+    next();
+    _out << json(name).dump() << ": ";
+    _afterKey = true;
+}
+
+void JsonWriter::value(const json& value)
+{
+    next();
+
+    // Indent the value's lines to the current depth
+    auto str = value.dump(indentSize);
+    const std::string indent(depth() * indentSize, ' ');
+    size_t start = 0;
+    for (auto pos = str.find('\n'); pos != std::string::npos;
+         pos = str.find('\n', start))
+    {
+        _out.write(str.data() + start, pos + 1 - start);
+        _out << indent;
+        start = pos + 1;
+    }
+    _out.write(str.data() + start, str.size() - start);
+}
+
+void JsonWriter::next()
+{
+    if (_afterKey)
+    {
+        // The value follows its key on the same line
+        _afterKey = false;
+        return;
+    }
+    if (!_containers.empty())
+    {
+        if (_containers.back())
+        {
+            _out << ',';
+        }
+        _containers.back() = true;
+        newline();
+    }
+}
+
+void JsonWriter::begin(char open)
+{
+    next();
+    _out << open;
+    _containers.push_back(false);
+}
+
+void JsonWriter::end(char close)
+{
+    bool hasValues = _containers.back();
+    _containers.pop_back();
+    if (hasValues)
+    {
+        newline();
+    }
+    _out << close;
+    if (_containers.empty())
+    {
+        _out << '\n';
+    }
+}
+
+void JsonWriter::newline()
+{
+    _out << '\n' << std::string(depth() * indentSize, ' ');
+}
+
+} // namespace phosphor::fan::control::json
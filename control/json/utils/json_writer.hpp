@@ -0,0 +1,139 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+/**
+ * @class JsonWriter
+ *
+ * Writes a JSON document to a stream piece by piece, so a large document
+ * never has to be built in memory first. Objects and arrays are opened and
+ * closed explicitly, while the values within them are written from small
+ * JSON values.
+ *
+ * The output is indented the same as dumping the whole document with an
+ * indent of 4.
+ */
+class JsonWriter
+{
+  public:
+    JsonWriter() = delete;
+    ~JsonWriter() = default;
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    JsonWriter(JsonWriter&&) = delete;
+    JsonWriter& operator=(JsonWriter&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] out - The stream to write to
+     */
+    explicit JsonWriter(std::ostream& out) : _out(out)
+    {}
+
+    /**
+     * @brief Open an object, as a value of the current object's key or
+     *        current array
+     */
+    void beginObject();
+
+    /**
+     * @brief Close the innermost object
+     */
+    void endObject();
+
+    /**
+     * @brief Open an array, as a value of the current object's key or
+     *        current array
+     */
+    void beginArray();
+
+    /**
+     * @brief Close the innermost array
+     */
+    void endArray();
+
+    /**
+     * @brief Write the key of the current object's next value
+     *
+     * @param[in] name - The key
+     */
+    void key(std::string_view name);
+
+    /**
+     * @brief Write a value, as a value of the current object's key or
+     *        current array
+     *
+     * @param[in] value - The value
+     */
+    void value(const json& value);
+
+    /**
+     * @brief Returns the depth of the objects and arrays opened
+     */
+    inline size_t depth() const
+    {
+        return _containers.size();
+    }
+
+  private:
+    /**
+     * @brief Start a new object key or array value, separating it from
+     *        the previous one
+     */
+    void next();
+
+    /**
+     * @brief Open an object or array
+     *
+     * @param[in] open - The opening character
+     */
+    void begin(char open);
+
+    /**
+     * @brief Close the innermost object or array
+     *
+     * @param[in] close - The closing character
+     */
+    void end(char close);
+
+    /**
+     * @brief Write a newline followed by the current indentation
+     */
+    void newline();
+
+    /* The stream written to */
+    std::ostream& _out;
+
+    /* If each object or array opened has any values yet */
+    std::vector<bool> _containers;
+
+    /* If a key was written that needs its value */
+    bool _afterKey = false;
+};
+
+} // namespace phosphor::fan::control::json
@@ -50,13 +50,11 @@ void PCIeCardMetadata::loadCards(const std::vector<std::string>& systemNames)
 
     if (fs::exists(confFile))
     {
-        FlightRecorder::instance().log(
-            "main",
-            fmt::format("Loading configuration from {}", confFile.string()));
+        FlightRecorder::instance().log("main", "Loading configuration from {}",
+                                       confFile.string());
         load(JsonConfig::load(confFile));
         FlightRecorder::instance().log(
-            "main", fmt::format("Configuration({}) loaded successfully",
-                                confFile.string()));
+            "main", "Configuration({}) loaded successfully", confFile.string());
         log<level::INFO>(fmt::format("Configuration({}) loaded successfully",
                                      confFile.string())
                              .c_str());
@@ -80,12 +78,11 @@ void PCIeCardMetadata::loadCards(const std::vector<std::string>& systemNames)
         if (fs::exists(confFile))
         {
             FlightRecorder::instance().log(
-                "main", fmt::format("Loading configuration from {}",
-                                    confFile.string()));
+                "main", "Loading configuration from {}", confFile.string());
             load(JsonConfig::load(confFile));
             FlightRecorder::instance().log(
-                "main", fmt::format("Configuration({}) loaded successfully",
-                                    confFile.string()));
+                "main", "Configuration({}) loaded successfully",
+                confFile.string());
             log<level::INFO>(
                 fmt::format("Configuration({}) loaded successfully",
                             confFile.string())
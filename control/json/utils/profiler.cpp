@@ -0,0 +1,110 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler.hpp"
+
+#include <algorithm>
+
+namespace phosphor::fan::control::json
+{
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::ID Profiler::getID(const std::string& category,
+                             const std::string& name)
+{
+    auto next = _released.empty() ? _stats.size() : _released.back();
+    auto [it, added] = _ids.emplace(category + ':' + name, next);
+    if (added)
+    {
+        if (next == _stats.size())
+        {
+            _stats.emplace_back();
+        }
+        else
+        {
+            _released.pop_back();
+        }
+        auto& stats = _stats[next];
+        stats.category = category;
+        stats.name = name;
+    }
+    return it->second;
+}
+
+void Profiler::release(ID id)
+{
+    auto& stats = _stats[id];
+    if (stats.category.empty())
+    {
+        return;
+    }
+    _ids.erase(stats.category + ':' + stats.name);
+    stats = Stats{};
+    _released.push_back(id);
+}
+
+void Profiler::record(ID id, std::chrono::nanoseconds duration)
+{
+    auto& stats = _stats[id];
+    uint64_t ns = duration.count();
+    stats.count++;
+    stats.totalNs += ns;
+    stats.maxNs = std::max(stats.maxNs, ns);
+
+    // Bucket by the number of significant bits of the microseconds
+    uint64_t us = ns / 1000;
+    size_t bucket = (us == 0) ? 0 : 64 - __builtin_clzll(us);
+    stats.buckets[std::min(bucket, numBuckets - 1)]++;
+}
+
+void Profiler::dump(json& data) const
+{
+    for (const auto& stats : _stats)
+    {
+        if (stats.category.empty())
+        {
+            continue;
+        }
+
+        // Keep the buckets in order as label and count pairs
+        json histogram = json::array();
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            if (stats.buckets[i] == 0)
+            {
+                continue;
+            }
+            auto label = (i < numBuckets - 1)
+                             ? "<" + std::to_string(1ULL << i) + "us"
+                             : ">=" + std::to_string(1ULL << (i - 1)) + "us";
+            histogram.push_back({label, stats.buckets[i]});
+        }
+
+        data[stats.category][stats.name] = {
+            {"count", stats.count},
+            {"total_us", stats.totalNs / 1000},
+            {"avg_us",
+             (stats.count == 0) ? 0 : stats.totalNs / stats.count / 1000},
+            {"max_us", stats.maxNs / 1000},
+            {"histogram", std::move(histogram)}};
+    }
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,170 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+/**
+ * @class Profiler
+ *
+ * Keeps latency statistics of what fan control runs: how many times each
+ * action and trigger ran, for how long in total and at most, and a
+ * histogram of how long each run took.
+ *
+ * Entries are interned up front so recording a run is just reading the
+ * monotonic clock twice and updating a few counters, which is cheap enough
+ * to always be on. A trigger's time includes the actions it runs, and an
+ * action's time includes any actions it runs itself.
+ *
+ * Entries of objects that go away, like the actions replaced by a config
+ * reload, are released so their IDs are reused.
+ */
+class Profiler
+{
+  public:
+    /* Interned ID of a profiled entry */
+    using ID = size_t;
+
+    /* Categories of profiled entries */
+    static constexpr auto actions = "actions";
+    static constexpr auto triggers = "triggers";
+
+    /* Number of histogram buckets. The first one holds the runs shorter
+     * than 1us, each next one the runs up to twice as long as the previous
+     * one, and the last one all the longer runs. */
+    static constexpr size_t numBuckets = 24;
+
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+
+    /**
+     * @brief Returns a reference to the static instance.
+     */
+    static Profiler& instance();
+
+    /**
+     * @brief Get the interned ID of an entry, interning it if needed
+     *
+     * @param[in] category - The category of the entry
+     * @param[in] name - The name of the entry
+     *
+     * @return - The interned ID
+     */
+    ID getID(const std::string& category, const std::string& name);
+
+    /**
+     * @brief Release an entry, dropping its statistics and letting its ID
+     *        be reused
+     *
+     * @param[in] id - The interned ID of the entry
+     */
+    void release(ID id);
+
+    /**
+     * @brief Record a run of an entry
+     *
+     * @param[in] id - The interned ID of the entry
+     * @param[in] duration - How long the run took
+     */
+    void record(ID id, std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Writes the statistics to JSON, grouped by category
+     *
+     * @param[out] data - Filled in with the statistics
+     */
+    void dump(json& data) const;
+
+    /**
+     * @class Scope
+     *
+     * Records a run of an entry lasting as long as the object's scope.
+     */
+    class Scope
+    {
+      public:
+        Scope() = delete;
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+        /**
+         * @brief Starts timing the run
+         *
+         * @param[in] id - The interned ID of the entry
+         */
+        explicit Scope(ID id) :
+            _id(id), _start(std::chrono::steady_clock::now())
+        {}
+
+        /**
+         * @brief Records the run
+         */
+        ~Scope()
+        {
+            Profiler::instance().record(
+                _id, std::chrono::steady_clock::now() - _start);
+        }
+
+      private:
+        /* The interned ID of the entry */
+        const ID _id;
+
+        /* When the run started */
+        const std::chrono::steady_clock::time_point _start;
+    };
+
+  private:
+    Profiler() = default;
+
+    /* The statistics of an entry, released when its category is empty */
+    struct Stats
+    {
+        std::string category;
+        std::string name;
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        std::array<uint64_t, numBuckets> buckets{};
+    };
+
+    /* The interned IDs, keyed by category and name */
+    std::unordered_map<std::string, ID> _ids;
+
+    /* The statistics indexed by interned ID */
+    std::vector<Stats> _stats;
+
+    /* The released IDs to reuse */
+    std::vector<ID> _released;
+};
+
+} // namespace phosphor::fan::control::json
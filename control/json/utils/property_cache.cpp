@@ -0,0 +1,162 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "property_cache.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace phosphor::fan::control::json
+{
+
+PropertyCache& PropertyCache::instance()
+{
+    static PropertyCache pc;
+    return pc;
+}
+
+PropertyCache::NameId PropertyCache::intern(const std::string& name)
+{
+    auto [it, added] = _ids.try_emplace(name, _names.size());
+    if (added)
+    {
+        // Keys of an unordered_map are never relocated
+        _names.emplace_back(&it->first);
+    }
+    return it->second;
+}
+
+std::optional<PropertyCache::NameId>
+    PropertyCache::findId(const std::string& name) const
+{
+    auto it = _ids.find(name);
+    if (it == _ids.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+PropertySlot PropertyCache::getSlot(const std::string& path,
+                                    const std::string& intf,
+                                    const std::string& prop)
+{
+    Key key{intern(path), intern(intf), intern(prop)};
+    auto [it, added] = _slots.try_emplace(key, _keys.size());
+    if (added)
+    {
+        _keys.emplace_back(key);
+        _values.emplace_back(std::nullopt);
+        _intfSlots[intfKey(key.path, key.intf)].emplace_back(it->second);
+    }
+    return it->second;
+}
+
+std::optional<PropertySlot>
+    PropertyCache::findSlot(const std::string& path, const std::string& intf,
+                            const std::string& prop) const
+{
+    auto pathId = findId(path);
+    auto intfId = findId(intf);
+    auto propId = findId(prop);
+    if (!pathId || !intfId || !propId)
+    {
+        return std::nullopt;
+    }
+
+    auto it = _slots.find(Key{*pathId, *intfId, *propId});
+    if (it == _slots.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void PropertyCache::removeInterface(const std::string& path,
+                                    const std::string& intf)
+{
+    auto pathId = findId(path);
+    auto intfId = findId(intf);
+    if (!pathId || !intfId)
+    {
+        return;
+    }
+
+    auto it = _intfSlots.find(intfKey(*pathId, *intfId));
+    if (it != _intfSlots.end())
+    {
+        for (const auto slot : it->second)
+        {
+            _values[slot].reset();
+        }
+    }
+}
+
+void PropertyCache::addInterest(const std::string& intf,
+                                const std::string& prop)
+{
+    _interests.insert(intfKey(intern(intf), intern(prop)));
+}
+
+bool PropertyCache::isInterested(const std::string& intf,
+                                 const std::string& prop) const
+{
+    auto intfId = findId(intf);
+    auto propId = findId(prop);
+    if (!intfId || !propId)
+    {
+        return false;
+    }
+    return _interests.find(intfKey(*intfId, *propId)) != _interests.end();
+}
+
+void PropertyCache::forEach(
+    const std::function<void(const std::string&, const std::string&,
+                             const std::string&, const PropertyVariantType&)>&
+        func) const
+{
+    for (PropertySlot slot = 0; slot < _values.size(); slot++)
+    {
+        if (_values[slot])
+        {
+            const auto& key = _keys[slot];
+            func(*_names[key.path], *_names[key.intf], *_names[key.prop],
+                 *_values[slot]);
+        }
+    }
+}
+
+std::vector<PropertySlot> PropertyCache::getSlotsByObject() const
+{
+    std::vector<PropertySlot> slots;
+    for (PropertySlot slot = 0; slot < _values.size(); slot++)
+    {
+        if (_values[slot])
+        {
+            slots.push_back(slot);
+        }
+    }
+
+    // Interned IDs group the same names without comparing strings
+    std::sort(slots.begin(), slots.end(), [this](auto left, auto right) {
+        const auto& l = _keys[left];
+        const auto& r = _keys[right];
+        return std::tie(l.path, l.intf, l.prop) <
+               std::tie(r.path, r.intf, r.prop);
+    });
+    return slots;
+}
+
+} // namespace phosphor::fan::control::json
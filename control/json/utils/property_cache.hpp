@@ -0,0 +1,282 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "config_base.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * Handle to a single path/interface/property entry within the property cache.
+ * Slots are resolved once (i.e. at config load) and stay valid for the life
+ * of the application, so lookups through them are a direct array index.
+ */
+using PropertySlot = size_t;
+
+/**
+ * @class PropertyCache
+ *
+ * This class stores the D-Bus property values used by fan control. Every
+ * path, interface, and property name is interned to an integer ID the first
+ * time it is seen, and each unique path/interface/property combination is
+ * given a slot in a flat array of values.
+ *
+ * Slots are never reused or removed, only their values are cleared, so a
+ * slot handle obtained from getSlot() can be held onto by groups and signal
+ * objects to read or write the value without any string compares.
+ */
+class PropertyCache
+{
+  public:
+    ~PropertyCache() = default;
+    PropertyCache(const PropertyCache&) = delete;
+    PropertyCache& operator=(const PropertyCache&) = delete;
+    PropertyCache(PropertyCache&&) = delete;
+    PropertyCache& operator=(PropertyCache&&) = delete;
+
+    /**
+     * @brief Returns a reference to the static instance.
+     */
+    static PropertyCache& instance();
+
+    /**
+     * @brief Get the slot of a path/interface/property, creating an empty
+     * slot for it when one does not exist yet
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     * @param[in] prop - Dbus object's property
+     *
+     * @return - The slot of the path/interface/property
+     */
+    PropertySlot getSlot(const std::string& path, const std::string& intf,
+                         const std::string& prop);
+
+    /**
+     * @brief Find the slot of a path/interface/property without creating it
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     * @param[in] prop - Dbus object's property
+     *
+     * @return - The slot, or std::nullopt if it has never been created
+     */
+    std::optional<PropertySlot> findSlot(const std::string& path,
+                                         const std::string& intf,
+                                         const std::string& prop) const;
+
+    /**
+     * @brief Get the value stored in a slot
+     *
+     * @param[in] slot - The slot to get the value of
+     *
+     * @return - Pointer to the value, or nullptr if the slot has no value
+     */
+    inline const PropertyVariantType* get(PropertySlot slot) const
+    {
+        const auto& value = _values[slot];
+        return value ? &(*value) : nullptr;
+    }
+
+    /**
+     * @brief Get the value stored in a slot
+     *
+     * @param[in] slot - The slot to get the value of
+     *
+     * @return - Reference to the value
+     *
+     * @throws - std::out_of_range when the slot has no value
+     */
+    inline const PropertyVariantType& at(PropertySlot slot) const
+    {
+        const auto* value = get(slot);
+        if (value == nullptr)
+        {
+            throw std::out_of_range("Property cache slot has no value");
+        }
+        return *value;
+    }
+
+    /**
+     * @brief Set the value stored in a slot
+     *
+     * @param[in] slot - The slot to set the value of
+     * @param[in] value - Value to store
+     */
+    inline void set(PropertySlot slot, PropertyVariantType value)
+    {
+        _values[slot] = std::move(value);
+    }
+
+    /**
+     * @brief Clear the value stored in a slot
+     *
+     * @param[in] slot - The slot to clear
+     */
+    inline void erase(PropertySlot slot)
+    {
+        _values[slot].reset();
+    }
+
+    /**
+     * @brief Clear the values of all properties on a path's interface
+     *
+     * @param[in] path - Dbus object's path
+     * @param[in] intf - Dbus object's interface
+     */
+    void removeInterface(const std::string& path, const std::string& intf);
+
+    /**
+     * @brief Add an interface's property to the properties of interest,
+     * the ones actually read from the cache
+     *
+     * @param[in] intf - Dbus interface
+     * @param[in] prop - Dbus property
+     */
+    void addInterest(const std::string& intf, const std::string& prop);
+
+    /**
+     * @brief Returns if an interface's property is of interest, so that
+     * properties nothing reads are kept out of the cache
+     *
+     * @param[in] intf - Dbus interface
+     * @param[in] prop - Dbus property
+     */
+    bool isInterested(const std::string& intf, const std::string& prop) const;
+
+    /**
+     * @brief Call a function for every slot containing a value
+     *
+     * @param[in] func - Function given the path, interface, property and value
+     */
+    void forEach(
+        const std::function<void(const std::string&, const std::string&,
+                                 const std::string&,
+                                 const PropertyVariantType&)>& func) const;
+
+    /**
+     * @brief Get the slots containing a value, with the slots of the same
+     * path and the same interface next to each other
+     *
+     * @return - The slots ordered by path, interface, and property
+     */
+    std::vector<PropertySlot> getSlotsByObject() const;
+
+    /**
+     * @brief Get the path, interface, and property of a slot
+     *
+     * @param[in] slot - The slot
+     *
+     * @return - The path, interface, and property names
+     */
+    inline std::tuple<const std::string&, const std::string&,
+                      const std::string&>
+        getNames(PropertySlot slot) const
+    {
+        const auto& key = _keys[slot];
+        return {*_names[key.path], *_names[key.intf], *_names[key.prop]};
+    }
+
+  private:
+    PropertyCache() = default;
+
+    /* Interned ID of a path, interface, or property name */
+    using NameId = uint32_t;
+
+    /* Interned IDs that uniquely identify a slot */
+    struct Key
+    {
+        NameId path;
+        NameId intf;
+        NameId prop;
+
+        bool operator==(const Key& other) const
+        {
+            return path == other.path && intf == other.intf &&
+                   prop == other.prop;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<uint64_t>{}(
+                (static_cast<uint64_t>(key.path) << 32 | key.intf) ^
+                (static_cast<uint64_t>(key.prop) << 16));
+        }
+    };
+
+    /**
+     * @brief Get the interned ID of a name, adding the name if not found
+     *
+     * @param[in] name - Name to intern
+     *
+     * @return - ID of the name
+     */
+    NameId intern(const std::string& name);
+
+    /**
+     * @brief Find the interned ID of a name
+     *
+     * @param[in] name - Name to find
+     *
+     * @return - ID of the name, or std::nullopt if never interned
+     */
+    std::optional<NameId> findId(const std::string& name) const;
+
+    /**
+     * @brief Combine a path ID and interface ID, or an interface ID and
+     * property ID, into a single key
+     */
+    static inline uint64_t intfKey(NameId path, NameId intf)
+    {
+        return static_cast<uint64_t>(path) << 32 | intf;
+    }
+
+    /* Map of interned names to their IDs */
+    std::unordered_map<std::string, NameId> _ids;
+
+    /* Interned names indexed by their IDs */
+    std::vector<const std::string*> _names;
+
+    /* Map of path/interface/property IDs to their slot */
+    std::unordered_map<Key, PropertySlot, KeyHash> _slots;
+
+    /* Path/interface/property IDs of each slot */
+    std::vector<Key> _keys;
+
+    /* Value of each slot */
+    std::vector<std::optional<PropertyVariantType>> _values;
+
+    /* Map of path/interface IDs to the slots of their properties */
+    std::unordered_map<uint64_t, std::vector<PropertySlot>> _intfSlots;
+
+    /* Interface/property IDs of the properties of interest */
+    std::unordered_set<uint64_t> _interests;
+};
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,202 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "query_server.hpp"
+
+#include <fmt/format.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace phosphor::fan::control::json
+{
+
+using namespace phosphor::logging;
+
+QueryServer::QueryServer(const sdeventplus::Event& event,
+                         const std::string& path, Handler&& handler) :
+    _event(event),
+    _path(path), _handler(std::move(handler))
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (_path.size() >= sizeof(addr.sun_path))
+    {
+        throw std::runtime_error{
+            fmt::format("Query socket path {} is too long", _path)};
+    }
+    std::strcpy(addr.sun_path, _path.c_str());
+
+    _fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_fd < 0)
+    {
+        throw std::runtime_error{fmt::format(
+            "Failed creating query socket: {}", std::strerror(errno))};
+    }
+
+    // Replace the socket of a previous instance
+    unlink(_path.c_str());
+    if ((bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) ||
+        (chmod(_path.c_str(), S_IRUSR | S_IWUSR) != 0) ||
+        (listen(_fd, SOMAXCONN) != 0))
+    {
+        auto err = errno;
+        close(_fd);
+        throw std::runtime_error{fmt::format(
+            "Failed listening on {}: {}", _path, std::strerror(err))};
+    }
+
+    _source = std::make_unique<sdeventplus::source::IO>(
+        _event, _fd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { accept(); });
+}
+
+QueryServer::~QueryServer()
+{
+    _connections.clear();
+    _source.reset();
+    close(_fd);
+    unlink(_path.c_str());
+}
+
+QueryServer::Connection::~Connection()
+{
+    source.reset();
+    close(fd);
+}
+
+void QueryServer::accept()
+{
+    while (true)
+    {
+        int fd = accept4(_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) &&
+                (errno != EINTR))
+            {
+                log<level::ERR>(fmt::format("Failed accepting query: {}",
+                                            std::strerror(errno))
+                                    .c_str());
+            }
+            if (errno != EINTR)
+            {
+                return;
+            }
+            continue;
+        }
+
+        auto conn = std::make_unique<Connection>();
+        conn->fd = fd;
+        conn->source = std::make_unique<sdeventplus::source::IO>(
+            _event, fd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int connFd, uint32_t) {
+                auto it = _connections.find(connFd);
+                if ((it != _connections.end()) && process(*it->second))
+                {
+                    _connections.erase(it);
+                }
+            });
+        _connections[fd] = std::move(conn);
+    }
+}
+
+bool QueryServer::process(Connection& conn)
+{
+    if (!conn.response.empty())
+    {
+        return write(conn);
+    }
+
+    char buf[512];
+    bool complete = false;
+    while (!complete)
+    {
+        auto size = recv(conn.fd, buf, sizeof(buf), 0);
+        if (size < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // Wait for the rest of the request, unless the read failed
+            return (errno != EAGAIN) && (errno != EWOULDBLOCK);
+        }
+        if (size == 0)
+        {
+            // The client closed its end after sending the request
+            if (conn.request.empty())
+            {
+                return true;
+            }
+            break;
+        }
+
+        conn.request.append(buf, size);
+        auto end = conn.request.find('\n');
+        if (end != std::string::npos)
+        {
+            conn.request.resize(end);
+            complete = true;
+        }
+        if (conn.request.size() > maxRequestSize)
+        {
+            return true;
+        }
+    }
+
+    try
+    {
+        conn.response = _handler(json::parse(conn.request)).dump();
+    }
+    catch (const std::exception& e)
+    {
+        conn.response = json{{"error", e.what()}}.dump();
+    }
+    conn.response += '\n';
+
+    conn.source->set_events(EPOLLOUT);
+    return write(conn);
+}
+
+bool QueryServer::write(Connection& conn)
+{
+    while (conn.written < conn.response.size())
+    {
+        auto size = send(conn.fd, conn.response.data() + conn.written,
+                         conn.response.size() - conn.written, MSG_NOSIGNAL);
+        if (size < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // Wait until the client reads more, unless the write failed
+            return (errno != EAGAIN) && (errno != EWOULDBLOCK);
+        }
+        conn.written += size;
+    }
+    return true;
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,141 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace phosphor::fan::control::json
+{
+
+using json = nlohmann::json;
+
+/**
+ * @class QueryServer
+ *
+ * Serves queries over a local UNIX stream socket from the event loop.
+ *
+ * A client connects, sends a single JSON request terminated by a newline,
+ * and then reads the JSON response until the server closes the connection.
+ * The requests and responses are read and written without blocking, so a
+ * slow client never stalls the event loop.
+ */
+class QueryServer
+{
+  public:
+    /* Function returning the response to a request */
+    using Handler = std::function<json(const json&)>;
+
+    /* Maximum size of a request */
+    static constexpr size_t maxRequestSize = 4096;
+
+    QueryServer() = delete;
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+    QueryServer(QueryServer&&) = delete;
+    QueryServer& operator=(QueryServer&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * Listens on the socket, replacing any left behind at its path.
+     *
+     * @param[in] event - The event loop to serve the queries from
+     * @param[in] path - Path of the socket
+     * @param[in] handler - Function returning the response to a request
+     *
+     * @throws std::runtime_error when the socket fails to be listened on
+     */
+    QueryServer(const sdeventplus::Event& event, const std::string& path,
+                Handler&& handler);
+
+    /**
+     * @brief Destructor
+     *
+     * Closes all connections and removes the socket.
+     */
+    ~QueryServer();
+
+  private:
+    /* A client's connection */
+    struct Connection
+    {
+        /* The connection's socket */
+        int fd = -1;
+
+        /* The request read so far */
+        std::string request;
+
+        /* The response and how much of it was written */
+        std::string response;
+        size_t written = 0;
+
+        /* Event source of the socket */
+        std::unique_ptr<sdeventplus::source::IO> source;
+
+        ~Connection();
+    };
+
+    /**
+     * @brief Accept the pending connections
+     */
+    void accept();
+
+    /**
+     * @brief Read a connection's request, and once it's complete write its
+     *        response
+     *
+     * @param[in] conn - The connection
+     *
+     * @return - If the connection is done and can be closed
+     */
+    bool process(Connection& conn);
+
+    /**
+     * @brief Write as much of a connection's response as the socket takes
+     *
+     * @param[in] conn - The connection
+     *
+     * @return - If the connection is done and can be closed
+     */
+    bool write(Connection& conn);
+
+    /* The event loop */
+    const sdeventplus::Event& _event;
+
+    /* Path of the socket */
+    std::string _path;
+
+    /* Function returning the response to a request */
+    Handler _handler;
+
+    /* The listening socket */
+    int _fd = -1;
+
+    /* Event source of the listening socket */
+    std::unique_ptr<sdeventplus::source::IO> _source;
+
+    /* The open connections keyed by their socket */
+    std::map<int, std::unique_ptr<Connection>> _connections;
+};
+
+} // namespace phosphor::fan::control::json
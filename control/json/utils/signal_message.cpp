@@ -0,0 +1,239 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "signal_message.hpp"
+
+#include <fmt/format.h>
+#include <systemd/sd-bus.h>
+
+#include <phosphor-logging/log.hpp>
+#include <sdbusplus/exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace phosphor::fan::control::json
+{
+
+using namespace phosphor::logging;
+
+bool SignalMessage::readProperties(Properties& props)
+{
+    auto* m = _msg.get();
+    if (sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sv}") < 0)
+    {
+        return false;
+    }
+
+    int r = 0;
+    while ((r = sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                               "sv")) > 0)
+    {
+        const char* name = nullptr;
+        if (sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &name) < 0)
+        {
+            return false;
+        }
+        PropertyVariantType value;
+        _msg.read(value);
+        props.emplace_back(name, std::move(value));
+
+        if (sd_bus_message_exit_container(m) < 0)
+        {
+            return false;
+        }
+    }
+
+    return (r >= 0) && (sd_bus_message_exit_container(m) >= 0);
+}
+
+const std::string& SignalMessage::objectPath()
+{
+    static constexpr auto objMgrIntf = "org.freedesktop.DBus.ObjectManager";
+
+    if (!_objectPath)
+    {
+        _objectPath.emplace();
+        const auto* intf = _msg.get_interface();
+        if ((intf != nullptr) && (std::strcmp(intf, objMgrIntf) == 0))
+        {
+            try
+            {
+                // Only the object path argument is needed from the message
+                sd_bus_message_rewind(_msg.get(), true);
+                sdbusplus::message::object_path op;
+                _msg.read(op);
+                *_objectPath = static_cast<const std::string&>(op);
+            }
+            catch (const std::exception& e)
+            {
+                log<level::ERR>(
+                    fmt::format("Failed to decode {} signal object path: {}",
+                                _msg.get_member(), e.what())
+                        .c_str());
+            }
+        }
+        else if (const auto* path = _msg.get_path())
+        {
+            *_objectPath = path;
+        }
+    }
+
+    return *_objectPath;
+}
+
+const SignalMessage::PropertiesChanged& SignalMessage::propertiesChanged()
+{
+    if (!_propertiesChanged)
+    {
+        _propertiesChanged.emplace();
+        try
+        {
+            sd_bus_message_rewind(_msg.get(), true);
+            _msg.read(_propertiesChanged->intf);
+            if (!readProperties(_propertiesChanged->props))
+            {
+                throw std::runtime_error("Invalid properties dictionary");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed to decode PropertiesChanged signal: {}",
+                            e.what())
+                    .c_str());
+            _propertiesChanged->props.clear();
+        }
+    }
+
+    return *_propertiesChanged;
+}
+
+const SignalMessage::InterfacesAdded& SignalMessage::interfacesAdded()
+{
+    if (!_interfacesAdded)
+    {
+        _interfacesAdded.emplace();
+        try
+        {
+            auto* m = _msg.get();
+            sd_bus_message_rewind(m, true);
+
+            sdbusplus::message::object_path op;
+            _msg.read(op);
+            _interfacesAdded->path = static_cast<const std::string&>(op);
+
+            auto valid = (sd_bus_message_enter_container(
+                              m, SD_BUS_TYPE_ARRAY, "{sa{sv}}") >= 0);
+            int r = 0;
+            while (valid && (r = sd_bus_message_enter_container(
+                                 m, SD_BUS_TYPE_DICT_ENTRY, "sa{sv}")) > 0)
+            {
+                const char* intf = nullptr;
+                valid = (sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING,
+                                                   &intf) >= 0);
+                if (valid)
+                {
+                    auto& props =
+                        _interfacesAdded->intfs.emplace_back(intf, Properties{})
+                            .second;
+                    valid = readProperties(props) &&
+                            (sd_bus_message_exit_container(m) >= 0);
+                }
+            }
+            if (!valid || r < 0 || sd_bus_message_exit_container(m) < 0)
+            {
+                throw std::runtime_error("Invalid interfaces dictionary");
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed to decode InterfacesAdded signal: {}",
+                            e.what())
+                    .c_str());
+            _interfacesAdded->intfs.clear();
+        }
+    }
+
+    return *_interfacesAdded;
+}
+
+const SignalMessage::InterfacesRemoved& SignalMessage::interfacesRemoved()
+{
+    if (!_interfacesRemoved)
+    {
+        _interfacesRemoved.emplace();
+        try
+        {
+            sd_bus_message_rewind(_msg.get(), true);
+
+            sdbusplus::message::object_path op;
+            _msg.read(op);
+            _interfacesRemoved->path = static_cast<const std::string&>(op);
+            _msg.read(_interfacesRemoved->intfs);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed to decode InterfacesRemoved signal: {}",
+                            e.what())
+                    .c_str());
+            _interfacesRemoved->intfs.clear();
+        }
+    }
+
+    return *_interfacesRemoved;
+}
+
+const SignalMessage::NameOwnerChanged& SignalMessage::nameOwnerChanged()
+{
+    if (!_nameOwnerChanged)
+    {
+        _nameOwnerChanged.emplace();
+        try
+        {
+            sd_bus_message_rewind(_msg.get(), true);
+            _msg.read(_nameOwnerChanged->name, _nameOwnerChanged->oldOwner,
+                      _nameOwnerChanged->newOwner);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed to decode NameOwnerChanged signal: {}",
+                            e.what())
+                    .c_str());
+        }
+    }
+
+    return *_nameOwnerChanged;
+}
+
+const PropertyVariantType*
+    SignalMessage::findProperty(const Properties& props,
+                                const std::string& name)
+{
+    auto it = std::find_if(props.begin(), props.end(),
+                           [&name](const auto& prop) {
+                               return prop.first == name;
+                           });
+    if (it == props.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+} // namespace phosphor::fan::control::json
@@ -0,0 +1,171 @@
+/**
+ * Copyright © 2022 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "config_base.hpp"
+
+#include <sdbusplus/message.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phosphor::fan::control::json
+{
+
+/**
+ * @class SignalMessage
+ *
+ * A view of a received signal's contents that is decoded at most once, no
+ * matter how many signal packages are subscribed to the signal. Each kind of
+ * content is only decoded the first time it's requested, so the handlers of
+ * every package subscribed to the same signal share the one decoded copy
+ * instead of rewinding and re-reading the message.
+ *
+ * Properties are kept in flat lists in the order they appear in the message
+ * since they are only ever searched for a single configured name.
+ */
+class SignalMessage
+{
+  public:
+    /* List of property names and their values */
+    using Properties = std::vector<std::pair<std::string, PropertyVariantType>>;
+
+    /* Contents of a PropertiesChanged signal */
+    struct PropertiesChanged
+    {
+        std::string intf;
+        Properties props;
+    };
+
+    /* Contents of an InterfacesAdded signal */
+    struct InterfacesAdded
+    {
+        std::string path;
+        std::vector<std::pair<std::string, Properties>> intfs;
+    };
+
+    /* Contents of an InterfacesRemoved signal */
+    struct InterfacesRemoved
+    {
+        std::string path;
+        std::vector<std::string> intfs;
+    };
+
+    /* Contents of a NameOwnerChanged signal */
+    struct NameOwnerChanged
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+    };
+
+    SignalMessage() = delete;
+    SignalMessage(const SignalMessage&) = delete;
+    SignalMessage(SignalMessage&&) = delete;
+    SignalMessage& operator=(const SignalMessage&) = delete;
+    SignalMessage& operator=(SignalMessage&&) = delete;
+    ~SignalMessage() = default;
+
+    /**
+     * Constructor
+     *
+     * @param[in] msg - The sdbusplus signal message to decode
+     */
+    explicit SignalMessage(sdbusplus::message::message& msg) : _msg(msg)
+    {}
+
+    /**
+     * @brief Get the sdbusplus signal message
+     */
+    inline auto& getMessage()
+    {
+        return _msg;
+    }
+
+    /**
+     * @brief Get the object path the signal is about
+     *
+     * This is the first argument of an ObjectManager InterfacesAdded or
+     * InterfacesRemoved signal, otherwise it's the path of the signal.
+     *
+     * @return - The object path
+     */
+    const std::string& objectPath();
+
+    /**
+     * @brief Get the contents of a PropertiesChanged signal
+     *
+     * @return - The interface and list of its changed properties
+     */
+    const PropertiesChanged& propertiesChanged();
+
+    /**
+     * @brief Get the contents of an InterfacesAdded signal
+     *
+     * @return - The path and list of its added interfaces and their properties
+     */
+    const InterfacesAdded& interfacesAdded();
+
+    /**
+     * @brief Get the contents of an InterfacesRemoved signal
+     *
+     * @return - The path and list of its removed interfaces
+     */
+    const InterfacesRemoved& interfacesRemoved();
+
+    /**
+     * @brief Get the contents of a NameOwnerChanged signal
+     *
+     * @return - The service name with its old and new owners
+     */
+    const NameOwnerChanged& nameOwnerChanged();
+
+    /**
+     * @brief Find a property's value in a list of properties
+     *
+     * @param[in] props - List of properties to search
+     * @param[in] name - Name of the property to find
+     *
+     * @return - Pointer to the property's value, or nullptr if not found
+     */
+    static const PropertyVariantType* findProperty(const Properties& props,
+                                                   const std::string& name);
+
+  private:
+    /**
+     * @brief Read a dictionary of property names to values from the
+     * message's current position
+     *
+     * @param[out] props - List the properties are appended to
+     *
+     * @return - Whether the dictionary was read successfully
+     */
+    bool readProperties(Properties& props);
+
+    /* The sdbusplus signal message */
+    sdbusplus::message::message& _msg;
+
+    /* The decoded contents of the signal */
+    std::optional<std::string> _objectPath;
+    std::optional<PropertiesChanged> _propertiesChanged;
+    std::optional<InterfacesAdded> _interfacesAdded;
+    std::optional<InterfacesRemoved> _interfacesRemoved;
+    std::optional<NameOwnerChanged> _nameOwnerChanged;
+};
+
+} // namespace phosphor::fan::control::json
@@ -53,7 +53,10 @@ Zone::Zone(const json& jsonObj, const sdeventplus::Event& event, Manager* mgr) :
     _incDelay(0), _decInterval(0), _floor(0), _target(0), _incDelta(0),
     _decDelta(0), _requestTargetBase(0), _isActive(true),
     _incTimer(event, std::bind(&Zone::incTimerExpired, this)),
-    _decTimer(event, std::bind(&Zone::decTimerExpired, this))
+    _decTimer(event, std::bind(&Zone::decTimerExpired, this)),
+    _targetRecorderID(
+        FlightRecorder::instance().getID("zone-target" + getName())),
+    _floorRecorderID(FlightRecorder::instance().getID("zone-floor" + getName()))
 {
     // Increase delay is optional, defaults to 0
     if (jsonObj.contains("increase_delay"))
@@ -146,10 +149,13 @@ void Zone::setTarget(uint64_t target)
     if (_isActive)
     {
         _target = target;
+        // Pipeline the writes to all the fans as a single batch
+        auto batch = std::make_shared<TargetBatch>();
         for (auto& fan : _fans)
         {
-            fan->setTarget(_target);
+            fan->setTarget(_target, batch);
         }
+        batch->complete();
     }
 }
 
@@ -199,16 +205,13 @@ void Zone::unlockFanTarget(const std::string& fname, uint64_t target)
 
 void Zone::setTargetHold(const std::string& ident, uint64_t target, bool hold)
 {
-    using namespace std::string_literals;
-
     if (!hold)
     {
         size_t removed = _targetHolds.erase(ident);
         if (removed)
         {
-            FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("{} is removing target hold", ident));
+            FlightRecorder::instance().log(_targetRecorderID,
+                                           "{} is removing target hold", ident);
         }
     }
     else
@@ -216,9 +219,9 @@ void Zone::setTargetHold(const std::string& ident, uint64_t target, bool hold)
         if (!((_targetHolds.find(ident) != _targetHolds.end()) &&
               (_targetHolds[ident] == target)))
         {
-            FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("{} is setting target hold to {}", ident, target));
+            FlightRecorder::instance().log(_targetRecorderID,
+                                           "{} is setting target hold to {}",
+                                           ident, target);
         }
         _targetHolds[ident] = target;
         _isActive = false;
@@ -236,24 +239,24 @@ void Zone::setTargetHold(const std::string& ident, uint64_t target, bool hold)
     {
         if (_target != itHoldMax->second)
         {
-            FlightRecorder::instance().log(
-                "zone-target"s + getName(),
-                fmt::format("Settings fans to target hold of {}",
-                            itHoldMax->second));
+            FlightRecorder::instance().log(_targetRecorderID,
+                                           "Settings fans to target hold of {}",
+                                           itHoldMax->second);
         }
 
         _target = itHoldMax->second;
+        // Pipeline the writes to all the fans as a single batch
+        auto batch = std::make_shared<TargetBatch>();
         for (auto& fan : _fans)
         {
-            fan->setTarget(_target);
+            fan->setTarget(_target, batch);
         }
+        batch->complete();
     }
 }
 
 void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
 {
-    using namespace std::string_literals;
-
     if (target > _ceiling)
     {
         target = _ceiling;
@@ -264,9 +267,8 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
         size_t removed = _floorHolds.erase(ident);
         if (removed)
         {
-            FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("{} is removing floor hold", ident));
+            FlightRecorder::instance().log(_floorRecorderID,
+                                           "{} is removing floor hold", ident);
         }
     }
     else
@@ -274,9 +276,9 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
         if (!((_floorHolds.find(ident) != _floorHolds.end()) &&
               (_floorHolds[ident] == target)))
         {
-            FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("{} is setting floor hold to {}", ident, target));
+            FlightRecorder::instance().log(_floorRecorderID,
+                                           "{} is setting floor hold to {}",
+                                           ident, target);
         }
         _floorHolds[ident] = target;
     }
@@ -296,9 +298,8 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
         if (_floor != _defaultFloor)
         {
             FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("No set floor exists, using default floor",
-                            _defaultFloor));
+                _floorRecorderID, "No set floor exists, using default floor",
+                _defaultFloor);
         }
         _floor = _defaultFloor;
     }
@@ -306,9 +307,9 @@ void Zone::setFloorHold(const std::string& ident, uint64_t target, bool hold)
     {
         if (_floor != itHoldMax->second)
         {
-            FlightRecorder::instance().log(
-                "zone-floor"s + getName(),
-                fmt::format("Setting new floor to {}", itHoldMax->second));
+            FlightRecorder::instance().log(_floorRecorderID,
+                                           "Setting new floor to {}",
+                                           itHoldMax->second);
         }
         _floor = itHoldMax->second;
     }
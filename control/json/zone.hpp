@@ -18,6 +18,7 @@
 #include "config_base.hpp"
 #include "dbus_zone.hpp"
 #include "fan.hpp"
+#include "utils/flight_recorder.hpp"
 
 #include <nlohmann/json.hpp>
 #include <sdeventplus/event.hpp>
@@ -476,6 +477,12 @@ class Zone : public ConfigBase
     /* Map of floor holds by a string identifier */
     std::unordered_map<std::string, uint64_t> _floorHolds;
 
+    /* Flight recorder ID of the target holds' messages */
+    FlightRecorder::ID _targetRecorderID;
+
+    /* Flight recorder ID of the floor holds' messages */
+    FlightRecorder::ID _floorRecorderID;
+
     /* Interface to property mapping of their associated set property handler
      * function */
     static const std::map<
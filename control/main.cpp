@@ -31,6 +31,7 @@
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <cstring>
 #include <fstream>
 
 using namespace phosphor::fan::control;
@@ -83,6 +84,21 @@ int main(int argc, char* argv[])
     try
     {
 #ifdef CONTROL_USE_JSON
+        // Keep the flight recorder in a file across crashes when configured
+        if (std::strlen(CONTROL_FLIGHT_RECORDER_FILE) != 0)
+        {
+            try
+            {
+                phosphor::fan::control::json::FlightRecorder::instance()
+                    .persistTo(CONTROL_FLIGHT_RECORDER_FILE);
+            }
+            catch (const std::runtime_error& e)
+            {
+                log<level::ERR>("Unable to keep the flight recorder in a file",
+                                entry("ERROR=%s", e.what()));
+            }
+        }
+
         phosphor::fan::control::json::FlightRecorder::instance().log("main",
                                                                      "Startup");
         json::Manager manager(event);
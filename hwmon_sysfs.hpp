@@ -0,0 +1,187 @@
+#pragma once
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace phosphor::fan::util
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class HwmonSysfs
+ *
+ * Reads and writes the attributes(i.e. fan1_input, pwm1, fan1_target) of a
+ * hwmon device directly through its sysfs directory, as an alternative to
+ * going through phosphor-hwmon's D-Bus sensors.
+ *
+ * The directory given can either be the hwmon directory itself
+ * (i.e. /sys/class/hwmon/hwmon3) or a device's hwmon directory containing it
+ * (i.e. /sys/bus/i2c/devices/7-0052/hwmon) since the hwmonN numbering is
+ * not guaranteed to be the same across boots.
+ *
+ * The directory the attributes are in is found on the first access and
+ * kept, so an access is just opening the attribute. It's only found again
+ * when an attribute can't be opened, like after the driver was rebound.
+ */
+class HwmonSysfs
+{
+  public:
+    HwmonSysfs() = delete;
+    ~HwmonSysfs() = default;
+    HwmonSysfs(const HwmonSysfs&) = default;
+    HwmonSysfs& operator=(const HwmonSysfs&) = default;
+    HwmonSysfs(HwmonSysfs&&) = default;
+    HwmonSysfs& operator=(HwmonSysfs&&) = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] path - The hwmon directory, or directory containing it
+     */
+    explicit HwmonSysfs(const fs::path& path) : _path(path)
+    {}
+
+    /**
+     * @brief Returns the configured directory
+     */
+    inline const fs::path& getPath() const
+    {
+        return _path;
+    }
+
+    /**
+     * @brief Reads an attribute's value
+     *
+     * @param[in] attr - The attribute name, i.e. fan1_input
+     *
+     * @return uint64_t - The value read
+     *
+     * @throws std::runtime_error when the attribute fails to be read
+     */
+    uint64_t read(const std::string& attr) const
+    {
+        auto path = getAttrPath(attr, false);
+        std::ifstream file{path};
+        if (!file.is_open())
+        {
+            path = getAttrPath(attr, true);
+            file.open(path);
+        }
+
+        uint64_t value = 0;
+        if (!(file >> value))
+        {
+            throw std::runtime_error{fmt::format(
+                "Failed reading hwmon attribute {}", path.string())};
+        }
+        return value;
+    }
+
+    /**
+     * @brief Writes an attribute's value
+     *
+     * @param[in] attr - The attribute name, i.e. pwm1
+     * @param[in] value - The value to write
+     *
+     * @throws std::runtime_error when the attribute fails to be written
+     */
+    void write(const std::string& attr, uint64_t value) const
+    {
+        // Opened without O_CREAT so attributes that don't exist aren't made
+        auto path = getAttrPath(attr, false);
+        int fd = open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+        if ((fd < 0) && (errno == ENOENT))
+        {
+            path = getAttrPath(attr, true);
+            fd = open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+        }
+        if (fd < 0)
+        {
+            throw std::runtime_error{
+                fmt::format("Failed opening hwmon attribute {}: {}",
+                            path.string(), std::strerror(errno))};
+        }
+
+        auto str = std::to_string(value);
+        auto size = ::write(fd, str.data(), str.size());
+        auto err = errno;
+        close(fd);
+        if (size != static_cast<ssize_t>(str.size()))
+        {
+            throw std::runtime_error{
+                fmt::format("Failed writing hwmon attribute {}: {}",
+                            path.string(), std::strerror(err))};
+        }
+    }
+
+  private:
+    /**
+     * @brief Get the path of an attribute within the directory the
+     *        attributes were found in
+     *
+     * @param[in] attr - The attribute name
+     * @param[in] find - Whether to find the directory again, because the
+     *                   attribute couldn't be opened in the kept one
+     *
+     * @return fs::path - The attribute's path
+     */
+    fs::path getAttrPath(const std::string& attr, bool find) const
+    {
+        if (find || _dir.empty())
+        {
+            _dir = findDir(attr);
+        }
+        return _dir / attr;
+    }
+
+    /**
+     * @brief Find the directory of an attribute, looking within a hwmonN
+     *        subdirectory when not found directly in the configured one
+     *
+     * @param[in] attr - The attribute name
+     *
+     * @return fs::path - The attribute's directory, or the configured one
+     *                    when not found
+     */
+    fs::path findDir(const std::string& attr) const
+    {
+        std::error_code ec;
+        if (fs::exists(_path / attr, ec))
+        {
+            return _path;
+        }
+
+        for (const auto& entry : fs::directory_iterator{_path, ec})
+        {
+            if ((entry.path().filename().string().rfind("hwmon", 0) == 0) &&
+                fs::exists(entry.path() / attr, ec))
+            {
+                return entry.path();
+            }
+        }
+
+        return _path;
+    }
+
+    /**
+     * @brief The configured directory
+     */
+    fs::path _path;
+
+    /**
+     * @brief The directory the attributes were last found in
+     */
+    mutable fs::path _dir;
+};
+
+} // namespace phosphor::fan::util
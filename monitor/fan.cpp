@@ -37,9 +37,9 @@ namespace monitor
 using namespace phosphor::logging;
 using namespace sdbusplus::bus::match;
 
-Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
+Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, TimerWheel& timers,
          std::unique_ptr<trust::Manager>& trust, const FanDefinition& def,
-         System& system) :
+         System& system, const FunctionalStates& states) :
     _bus(bus),
     _name(std::get<fanNameField>(def)),
     _deviation(std::get<fanDeviationField>(def)),
@@ -47,7 +47,7 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
     _trustManager(trust),
 #ifdef MONITOR_USE_JSON
     _monitorDelay(std::get<monitorStartDelayField>(def)),
-    _monitorTimer(event, std::bind(std::mem_fn(&Fan::startMonitor), this)),
+    _monitorTimer(timers, std::bind(std::mem_fn(&Fan::startMonitor), this)),
 #endif
     _system(system),
     _presenceMatch(bus,
@@ -76,7 +76,8 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
             std::get<thresholdField>(s), std::get<ignoreAboveMaxField>(s),
             std::get<timeoutField>(def),
             std::get<nonfuncRotorErrDelayField>(def),
-            std::get<countIntervalField>(def), event));
+            std::get<countIntervalField>(def), std::get<hwmonField>(s),
+            states, timers));
 
         _trustManager->registerSensor(_sensors.back());
     }
@@ -85,16 +86,20 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
         (_numSensorFailsForNonFunc == 0) ||
         (countNonFunctionalSensors() < _numSensorFailsForNonFunc);
 
-    if (updateInventory(functionalState) && !functionalState)
+    InventoryNotifier::ErrorCallback onError;
+    if (!functionalState)
     {
-        // the inventory update threw an exception, possibly because D-Bus
-        // wasn't ready. Try to update sensors back to functional to avoid a
+        // If the inventory update fails, possibly because D-Bus wasn't
+        // ready, try to update sensors back to functional to avoid a
         // false-alarm. They will be updated again from subscribing to the
         // properties-changed event
-
-        for (auto& sensor : _sensors)
-            sensor->setFunctional(true);
+        onError = [this]() {
+            for (auto& sensor : _sensors)
+                sensor->setFunctional(true);
+            _system.fanStatusChange(*this, true);
+        };
     }
+    updateInventory(functionalState, std::move(onError));
 
 #ifndef MONITOR_USE_JSON
     // Check current tach state when entering monitor mode
@@ -115,10 +120,9 @@ Fan::Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
 
     if (_fanMissingErrorDelay)
     {
-        _fanMissingErrorTimer = std::make_unique<
-            sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
-            event, std::bind(&System::fanMissingErrorTimerExpired, &system,
-                             std::ref(*this)));
+        _fanMissingErrorTimer = std::make_unique<TimerWheel::Timer>(
+            timers, std::bind(&System::fanMissingErrorTimerExpired, &system,
+                              std::ref(*this)));
     }
 
     try
@@ -422,41 +426,19 @@ void Fan::updateState(TachSensor& sensor)
     _system.fanStatusChange(*this);
 }
 
-bool Fan::updateInventory(bool functional)
+void Fan::updateInventory(bool functional,
+                          InventoryNotifier::ErrorCallback onError)
 {
-    bool dbusError = false;
-
-    try
-    {
-        auto objectMap =
-            util::getObjMap<bool>(_name, util::OPERATIONAL_STATUS_INTF,
-                                  util::FUNCTIONAL_PROPERTY, functional);
-
-        auto response = util::SDBusPlus::callMethod(
-            _bus, util::INVENTORY_SVC, util::INVENTORY_PATH,
-            util::INVENTORY_INTF, "Notify", objectMap);
-
-        if (response.is_method_error())
-        {
-            log<level::ERR>("Error in Notify call to update inventory");
-
-            dbusError = true;
-        }
-    }
-    catch (const util::DBusError& e)
-    {
-        dbusError = true;
-
-        getLogger().log(
-            fmt::format("D-Bus Exception reading/updating inventory : {}",
-                        e.what()),
-            Logger::error);
-    }
+    _system.getInventoryNotifier().update(_name, functional,
+                                          std::move(onError));
 
     // This will always track the current state of the inventory.
     _functional = functional;
+}
 
-    return dbusError;
+InventoryNotifier& Fan::getInventoryNotifier()
+{
+    return _system.getInventoryNotifier();
 }
 
 void Fan::presenceChanged(sdbusplus::message::message& msg)
@@ -502,6 +484,9 @@ void Fan::presenceChanged(sdbusplus::message::message& msg)
 
 void Fan::sensorErrorTimerExpired(const TachSensor& sensor)
 {
+    // The sensor's error is no longer pending
+    _system.fanStatusChange(*this, true);
+
     if (_present && _system.isPowerOn())
     {
         _system.sensorErrorTimerExpired(*this, sensor);
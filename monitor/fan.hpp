@@ -2,6 +2,7 @@
 
 #include "config.h"
 
+#include "inventory_notifier.hpp"
 #include "tach_sensor.hpp"
 #include "trust_manager.hpp"
 #include "types.hpp"
@@ -75,14 +76,15 @@ class Fan
      *
      * @param mode - mode of fan monitor
      * @param bus - the dbus object
-     * @param event - event loop reference
+     * @param timers - timer wheel to run the fan's timers on
      * @param trust - the tach trust manager
      * @param def - the fan definition structure
      * @param system - Reference to the system object
+     * @param states - Inventory functional states snapshot for the sensors
      */
-    Fan(Mode mode, sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
+    Fan(Mode mode, sdbusplus::bus::bus& bus, TimerWheel& timers,
         std::unique_ptr<trust::Manager>& trust, const FanDefinition& def,
-        System& system);
+        System& system, const FunctionalStates& states);
 
     /**
      * @brief Callback function for when an input sensor changes
@@ -139,6 +141,11 @@ class Fan
         return _sensors;
     }
 
+    /**
+     * @brief Returns the queue of fan and sensor inventory updates
+     */
+    InventoryNotifier& getInventoryNotifier();
+
     /**
      * @brief Returns the presence status of the fan
      *
@@ -208,15 +215,15 @@ class Fan
     size_t countNonFunctionalSensors() const;
 
     /**
-     * @brief Updates the Functional property in the inventory
-     *        for the fan based on the value passed in.
+     * @brief Queues an update of the Functional property in the
+     *        inventory for the fan based on the value passed in.
      *
      * @param[in] functional - If the Functional property should
      *                         be set to true or false.
-     *
-     * @return - True if an exception was encountered during update
+     * @param[in] onError - Optional function to call if the update fails
      */
-    bool updateInventory(bool functional);
+    void updateInventory(bool functional,
+                         InventoryNotifier::ErrorCallback onError = nullptr);
 
     /**
      * @brief Called by _monitorTimer to start fan monitoring some
@@ -294,7 +301,7 @@ class Fan
     /**
      * @brief Expires after _monitorDelay to start fan monitoring.
      */
-    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _monitorTimer;
+    TimerWheel::Timer _monitorTimer;
 #endif
 
     /**
@@ -336,9 +343,7 @@ class Fan
      * @brief The timer that uses the _fanMissingErrorDelay timeout,
      *        at the end of which an event log will be created.
      */
-    std::unique_ptr<
-        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
-        _fanMissingErrorTimer;
+    std::unique_ptr<TimerWheel::Timer> _fanMissingErrorTimer;
 
     /**
      * @brief If the fan and sensors should be set to functional when
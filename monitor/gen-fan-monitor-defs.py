@@ -79,7 +79,8 @@ const std::vector<FanDefinition> fanDefinitions
                                        ${factor},
                                        ${offset},
                                        ${threshold},
-                                       ${ignore_above_max}},
+                                       ${ignore_above_max},
+                                       std::nullopt},
                   %endfor
                   },
                   %if ('condition' in fan_data) and \
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "logging.hpp"
+#include "sdbusplus.hpp"
+
+#include <fmt/format.h>
+
+#include <phosphor-logging/log.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace phosphor::fan::monitor
+{
+
+/**
+ * @class InventoryNotifier
+ *
+ * Queues updates of the Functional property of fan and tach sensor inventory
+ * objects and sends them to the inventory manager in a single Notify call,
+ * once per event loop iteration. This keeps a burst of state changes, like
+ * when a fan is pulled, from becoming a burst of D-Bus method calls.
+ *
+ * A later update of an object replaces an update of it that is still queued.
+ */
+class InventoryNotifier
+{
+  public:
+    /* Function called when the Notify carrying an update failed */
+    using ErrorCallback = std::function<void()>;
+
+    InventoryNotifier() = delete;
+    ~InventoryNotifier() = default;
+    InventoryNotifier(const InventoryNotifier&) = delete;
+    InventoryNotifier& operator=(const InventoryNotifier&) = delete;
+    InventoryNotifier(InventoryNotifier&&) = delete;
+    InventoryNotifier& operator=(InventoryNotifier&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] bus - The sdbusplus bus object
+     * @param[in] event - The event loop the queued updates are sent from
+     */
+    InventoryNotifier(sdbusplus::bus::bus& bus,
+                      const sdeventplus::Event& event) :
+        _bus(bus),
+        _event(event)
+    {}
+
+    /**
+     * @brief Queue an update of an object's Functional property
+     *
+     * @param[in] path - The object's path relative to the inventory root
+     * @param[in] functional - The Functional property value
+     * @param[in] onError - Optional function to call if the update fails
+     */
+    void update(const std::string& path, bool functional,
+                ErrorCallback onError = nullptr)
+    {
+        _pending[path] = std::make_pair(functional, std::move(onError));
+
+        if (!_flushSource)
+        {
+            _flushSource = std::make_unique<sdeventplus::source::Defer>(
+                _event, [this](sdeventplus::source::EventBase&) { flush(); });
+        }
+    }
+
+    /**
+     * @brief Send the queued updates now instead of waiting for the next
+     *        event loop iteration
+     *
+     * Updates queued by the error callbacks of a failed Notify are sent
+     * before returning.
+     */
+    void flush()
+    {
+        while (!_pending.empty())
+        {
+            auto pending = std::move(_pending);
+            _pending.clear();
+
+            ObjectMap objectMap;
+            for (const auto& [path, update] : pending)
+            {
+                objectMap[path][util::OPERATIONAL_STATUS_INTF]
+                         [util::FUNCTIONAL_PROPERTY] = update.first;
+            }
+
+            bool dbusError = false;
+            try
+            {
+                auto response = util::SDBusPlus::callMethod(
+                    _bus, util::INVENTORY_SVC, util::INVENTORY_PATH,
+                    util::INVENTORY_INTF, "Notify", objectMap);
+
+                if (response.is_method_error())
+                {
+                    phosphor::logging::log<phosphor::logging::level::ERR>(
+                        "Error in Notify call to update inventory");
+                    dbusError = true;
+                }
+            }
+            catch (const util::DBusError& e)
+            {
+                dbusError = true;
+
+                getLogger().log(
+                    fmt::format("D-Bus Exception updating inventory : {}",
+                                e.what()),
+                    Logger::error);
+            }
+
+            if (dbusError)
+            {
+                for (auto& [path, update] : pending)
+                {
+                    if (update.second)
+                    {
+                        update.second();
+                    }
+                }
+            }
+        }
+
+        _flushSource.reset();
+    }
+
+  private:
+    using PropertyMap = std::map<std::string, std::variant<bool>>;
+    using InterfaceMap = std::map<std::string, PropertyMap>;
+    using ObjectMap = std::map<sdbusplus::message::object_path, InterfaceMap>;
+
+    /* The sdbusplus bus object */
+    sdbusplus::bus::bus& _bus;
+
+    /* The event loop */
+    const sdeventplus::Event& _event;
+
+    /* Queued Functional values and error callbacks keyed by object path */
+    std::map<std::string, std::pair<bool, ErrorCallback>> _pending;
+
+    /* Event source that sends the queued updates */
+    std::unique_ptr<sdeventplus::source::Defer> _flushSource;
+};
+
+} // namespace phosphor::fan::monitor
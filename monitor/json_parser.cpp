@@ -124,6 +124,35 @@ const std::vector<CreateGroupFunction> getTrustGrps(const json& obj)
     return grpFuncs;
 }
 
+const HwmonDefinition getHwmonDef(const json& hwmon, bool hasTarget)
+{
+    if (!hwmon.contains("path") || !hwmon.contains("input") ||
+        (hasTarget && !hwmon.contains("target")))
+    {
+        log<level::ERR>(
+            "Missing required fan sensor hwmon parameters",
+            entry("REQUIRED_PARAMETERS=%s", "{path, input, target}"));
+        throw std::runtime_error(
+            "Missing required fan sensor hwmon parameters");
+    }
+
+    std::string target;
+    if (hasTarget)
+    {
+        target = hwmon["target"].get<std::string>();
+    }
+    // Poll interval is optional and defaults to 1 second
+    size_t pollInterval = 1000;
+    if (hwmon.contains("poll_interval"))
+    {
+        pollInterval = hwmon["poll_interval"].get<size_t>();
+    }
+
+    return HwmonDefinition{hwmon["path"].get<std::string>(),
+                           hwmon["input"].get<std::string>(), target,
+                           pollInterval};
+}
+
 const std::vector<SensorDefinition> getSensorDefs(const json& sensors)
 {
     std::vector<SensorDefinition> sensorDefs;
@@ -171,9 +200,18 @@ const std::vector<SensorDefinition> getSensorDefs(const json& sensors)
             ignoreAboveMax = sensor["ignore_above_max"].get<bool>();
         }
 
+        // Reading the sensor directly from hwmon sysfs is optional,
+        // defaults to reading it from D-Bus
+        std::optional<HwmonDefinition> hwmon;
+        if (sensor.contains("hwmon"))
+        {
+            hwmon = getHwmonDef(sensor["hwmon"],
+                                sensor["has_target"].get<bool>());
+        }
+
         sensorDefs.emplace_back(std::tuple(
             sensor["name"].get<std::string>(), sensor["has_target"].get<bool>(),
-            targetIntf, factor, offset, threshold, ignoreAboveMax));
+            targetIntf, factor, offset, threshold, ignoreAboveMax, hwmon));
     }
 
     return sensorDefs;
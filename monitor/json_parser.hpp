@@ -63,6 +63,16 @@ inline const json getJsonObj(sdbusplus::bus::bus& bus)
  */
 const std::vector<CreateGroupFunction> getTrustGrps(const json& obj);
 
+/**
+ * @brief Get the configured hwmon sysfs attributes of a sensor
+ *
+ * @param[in] hwmon - JSON object containing the hwmon attributes
+ * @param[in] hasTarget - Whether the sensor has a target
+ *
+ * @return The hwmon definition of the sensor
+ */
+const HwmonDefinition getHwmonDef(const json& hwmon, bool hasTarget);
+
 /**
  * @brief Get the configured sensor definitions that make up a fan
  *
@@ -22,6 +22,7 @@
 #ifdef MONITOR_USE_JSON
 #include "json_config.hpp"
 #include "json_parser.hpp"
+#include "sdbusplus.hpp"
 #endif
 #include "system.hpp"
 #include "trust_manager.hpp"
@@ -66,6 +67,7 @@ int main(int argc, char* argv[])
     // Attach the event object to the bus object so we can
     // handle both sd_events (for the timers) and dbus signals.
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+    phosphor::fan::util::SDBusPlus::enableServiceCache(bus);
 
     System system(mode, bus, event);
 
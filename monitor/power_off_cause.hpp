@@ -2,8 +2,7 @@
 
 #include "types.hpp"
 
-#include <algorithm>
-#include <vector>
+#include <string>
 
 namespace phosphor::fan::monitor
 {
@@ -109,12 +108,7 @@ class MissingFanFRUCause : public PowerOffCause
      */
     bool satisfied(const FanHealth& fanHealth) override
     {
-        size_t count = std::count_if(
-            fanHealth.begin(), fanHealth.end(), [](const auto& fan) {
-                return !std::get<presentHealthPos>(fan.second);
-            });
-
-        return count >= _count;
+        return fanHealth.missingFans() >= _count;
     }
 };
 
@@ -152,17 +146,7 @@ class NonfuncFanRotorCause : public PowerOffCause
      */
     bool satisfied(const FanHealth& fanHealth) override
     {
-        size_t count = std::accumulate(
-            fanHealth.begin(), fanHealth.end(), 0,
-            [](int sum, const auto& fan) {
-                const auto& tachs = std::get<sensorFuncHealthPos>(fan.second);
-                auto nonFuncTachs =
-                    std::count_if(tachs.begin(), tachs.end(),
-                                  [](bool tach) { return !tach; });
-                return sum + nonFuncTachs;
-            });
-
-        return count >= _count;
+        return fanHealth.nonfuncRotors() >= _count;
     }
 };
 
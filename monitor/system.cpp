@@ -36,6 +36,10 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/signal.hpp>
 
+#include <map>
+#include <variant>
+#include <vector>
+
 namespace phosphor::fan::monitor
 {
 
@@ -47,7 +51,7 @@ using namespace phosphor::logging;
 System::System(Mode mode, sdbusplus::bus::bus& bus,
                const sdeventplus::Event& event) :
     _mode(mode),
-    _bus(bus), _event(event),
+    _bus(bus), _event(event), _inventory(bus, event), _timers(event),
     _powerState(std::make_unique<PGoodState>(
         bus, std::bind(std::mem_fn(&System::powerStateChanged), this,
                        std::placeholders::_1))),
@@ -90,12 +94,16 @@ void System::load()
         auto fanDefs = getFanDefinitions(jsonObj);
         // Retrieve and set trust groups within the trust manager
         setTrustMgr(getTrustGroups(jsonObj));
+        // Send any updates queued by the current fans before clearing them
+        _inventory.flush();
         // Clear/set configured fan definitions
         _fans.clear();
         _fanHealth.clear();
         // Retrieve fan definitions and create fan objects to be monitored
         setFans(fanDefs);
         setFaultConfig(jsonObj);
+        // Send the initial fan and sensor states in one Notify right away
+        _inventory.flush();
         log<level::INFO>("Configuration loaded");
 
         _loaded = true;
@@ -256,6 +264,9 @@ const std::vector<FanDefinition> System::getFanDefinitions(const json& jsonObj)
 
 void System::setFans(const std::vector<FanDefinition>& fanDefs)
 {
+    // One snapshot of the inventory functional states shared by all sensors
+    auto states = getFunctionalStates();
+
     for (const auto& fanDef : fanDefs)
     {
         // Check if a condition exists on the fan
@@ -268,11 +279,100 @@ void System::setFans(const std::vector<FanDefinition>& fanDefs)
                 continue;
             }
         }
-        _fans.emplace_back(
-            std::make_unique<Fan>(_mode, _bus, _event, _trust, fanDef, *this));
+        _fans.emplace_back(std::make_unique<Fan>(_mode, _bus, _timers, _trust,
+                                                 fanDef, *this, states));
 
         updateFanHealth(*(_fans.back()));
     }
+
+    updateSensorsInventory();
+}
+
+FunctionalStates System::getFunctionalStates()
+{
+    FunctionalStates states;
+
+    try
+    {
+        // see if any object paths in the inventory have the
+        // OperationalStatus interface.
+        auto subtree = util::SDBusPlus::getSubTreeRaw(
+            _bus, util::INVENTORY_PATH, util::OPERATIONAL_STATUS_INTF, 0);
+
+        std::map<std::string, std::vector<std::string>> servicePaths;
+        for (const auto& [path, services] : subtree)
+        {
+            for (const auto& service : services)
+            {
+                servicePaths[service.first].push_back(path);
+            }
+        }
+
+        for (const auto& [service, paths] : servicePaths)
+        {
+            try
+            {
+                auto objects =
+                    util::SDBusPlus::getManagedObjects<std::variant<bool>>(
+                        _bus, service, util::INVENTORY_PATH);
+                for (const auto& path : paths)
+                {
+                    auto object = objects.find(path);
+                    if (object == objects.end())
+                    {
+                        continue;
+                    }
+                    auto intf = object->second.find(
+                        util::OPERATIONAL_STATUS_INTF);
+                    if (intf == object->second.end())
+                    {
+                        continue;
+                    }
+                    auto prop = intf->second.find(util::FUNCTIONAL_PROPERTY);
+                    if ((prop != intf->second.end()) &&
+                        std::holds_alternative<bool>(prop->second))
+                    {
+                        states[path] = std::get<bool>(prop->second);
+                    }
+                }
+            }
+            catch (const util::DBusError& e)
+            {
+                // The service has no object manager at the inventory root,
+                // so read each of its objects' functional state instead
+                for (const auto& path : paths)
+                {
+                    try
+                    {
+                        states[path] = util::SDBusPlus::getProperty<bool>(
+                            _bus, service, path, util::OPERATIONAL_STATUS_INTF,
+                            util::FUNCTIONAL_PROPERTY);
+                    }
+                    catch (const util::DBusError& pe)
+                    {
+                        log<level::DEBUG>(pe.what());
+                    }
+                }
+            }
+        }
+    }
+    catch (const util::DBusError& e)
+    {
+        log<level::DEBUG>(e.what());
+    }
+
+    return states;
+}
+
+void System::updateSensorsInventory()
+{
+    for (const auto& fan : _fans)
+    {
+        for (const auto& sensor : fan->sensors())
+        {
+            _inventory.update(sensor->getInvName(), sensor->functional());
+        }
+    }
 }
 
 // callback indicating a service went [on|off]line.
@@ -312,13 +412,19 @@ void System::tachSignalOffline(sdbusplus::message::message& msg,
 void System::updateFanHealth(const Fan& fan)
 {
     std::vector<bool> sensorStatus;
+    size_t pendingErrors = 0;
     for (const auto& sensor : fan.sensors())
     {
         sensorStatus.push_back(sensor->functional());
+        if (!sensor->functional() && sensor->errorTimerRunning())
+        {
+            pendingErrors++;
+        }
     }
 
-    _fanHealth[fan.getName()] =
-        std::make_tuple(fan.present(), std::move(sensorStatus));
+    _fanHealth.set(fan.getName(),
+                   std::make_tuple(fan.present(), std::move(sensorStatus)));
+    _fanHealth.setPendingErrors(fan.getName(), pendingErrors);
 }
 
 void System::fanStatusChange(const Fan& fan, bool skipRulesCheck)
@@ -409,20 +515,11 @@ void System::sensorErrorTimerExpired(const Fan& fan, const TachSensor& sensor)
     // In order to know if the event log should have a severity of error or
     // informational, count the number of existing nonfunctional sensors and
     // compare it to _numNonfuncSensorsBeforeError.
-    size_t nonfuncSensors = 0;
-    for (const auto& fan : _fans)
-    {
-        for (const auto& s : fan->sensors())
-        {
-            // Don't count nonfunctional sensors that still have their
-            // error timer running as nonfunctional since they haven't
-            // had event logs created for those errors yet.
-            if (!s->functional() && !s->errorTimerRunning())
-            {
-                nonfuncSensors++;
-            }
-        }
-    }
+    // Don't count nonfunctional sensors that still have their error timer
+    // running as nonfunctional since they haven't had event logs created
+    // for those errors yet.
+    size_t nonfuncSensors =
+        _fanHealth.nonfuncRotors() - _fanHealth.pendingErrorRotors();
 
     Severity severity = Severity::Error;
     if (nonfuncSensors < _numNonfuncSensorsBeforeError)
@@ -492,6 +589,9 @@ json System::captureSensorData()
         }
     }
 
+    data["timers"]["enabled"] = _timers.size();
+    data["timers"]["wakeups"] = _timers.getWakeups();
+
     return data;
 }
 
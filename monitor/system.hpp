@@ -17,9 +17,11 @@
 
 #include "fan.hpp"
 #include "fan_error.hpp"
+#include "inventory_notifier.hpp"
 #include "power_off_rule.hpp"
 #include "power_state.hpp"
 #include "tach_sensor.hpp"
+#include "timer_wheel.hpp"
 #include "trust_manager.hpp"
 #include "types.hpp"
 
@@ -112,6 +114,14 @@ class System
         return _powerState->isPowerOn();
     }
 
+    /**
+     * @brief Returns the queue of fan and sensor inventory updates
+     */
+    inline InventoryNotifier& getInventoryNotifier()
+    {
+        return _inventory;
+    }
+
     /**
      * @brief tests the presence of Inventory and calls load() if present, else
      *  waits for Inventory asynchronously and has a callback to load() when
@@ -141,6 +151,12 @@ class System
     /* The event loop reference */
     const sdeventplus::Event& _event;
 
+    /* Queue of fan and sensor inventory updates */
+    InventoryNotifier _inventory;
+
+    /* Timer wheel all the fan and sensor timers are run on */
+    TimerWheel _timers;
+
     /* Trust manager of trust groups */
     std::unique_ptr<phosphor::fan::trust::Manager> _trust;
 
@@ -241,6 +257,24 @@ class System
      */
     void setFans(const std::vector<FanDefinition>& fanDefs);
 
+    /**
+     * @brief Get the functional states of the inventory objects with the
+     *        OperationalStatus interface
+     *
+     * A single subtree lookup finds the objects, which are then read with
+     * one GetManagedObjects call per service hosting them instead of a
+     * lookup and property read per tach sensor.
+     *
+     * @return The functional states keyed by inventory object path
+     */
+    FunctionalStates getFunctionalStates();
+
+    /**
+     * @brief Queues the Functional property updates in the inventory of
+     *        every tach sensor
+     */
+    void updateSensorsInventory();
+
     /**
      * @brief Updates the fan health map entry for the fan passed in
      *
@@ -74,43 +74,29 @@ TachSensor::TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
                        int64_t offset, size_t method, size_t threshold,
                        bool ignoreAboveMax, size_t timeout,
                        const std::optional<size_t>& errorDelay,
-                       size_t countInterval, const sdeventplus::Event& event) :
+                       size_t countInterval,
+                       const std::optional<HwmonDefinition>& hwmon,
+                       const FunctionalStates& states, TimerWheel& timers) :
     _bus(bus),
     _fan(fan), _name(FAN_SENSOR_PATH + id), _invName(path(fan.getName()) / id),
     _hasTarget(hasTarget), _funcDelay(funcDelay), _interface(interface),
     _factor(factor), _offset(offset), _method(method), _threshold(threshold),
     _ignoreAboveMax(ignoreAboveMax), _timeout(timeout),
     _timerMode(TimerMode::func),
-    _timer(event, std::bind(&Fan::updateState, &fan, std::ref(*this))),
-    _errorDelay(errorDelay), _countInterval(countInterval)
+    _timer(timers, std::bind(&Fan::updateState, &fan, std::ref(*this))),
+    _errorDelay(errorDelay), _countInterval(countInterval), _hwmonDef(hwmon)
 {
-    // Query functional state from inventory
-    // TODO - phosphor-fan-presence/issues/25
-
-    _functional = true;
-
-    try
-    {
-        // see if any object paths in the inventory have the
-        // OperationalStatus interface.
-        auto subtree = util::SDBusPlus::getSubTreeRaw(
-            _bus, util::INVENTORY_PATH, util::OPERATIONAL_STATUS_INTF, 0);
-
-        // if the tach sensor's entry already exists, we for sure can
-        // read its functional state from the inventory
-        if (subtree.end() != subtree.find(util::INVENTORY_PATH + _invName))
-        {
-            _functional = util::SDBusPlus::getProperty<bool>(
-                _bus, util::INVENTORY_PATH + _invName,
-                util::OPERATIONAL_STATUS_INTF, util::FUNCTIONAL_PROPERTY);
-        }
-    }
-    catch (const util::DBusError& e)
+    if (_hwmonDef)
     {
-        log<level::DEBUG>(e.what());
+        _hwmon = std::make_unique<util::HwmonSysfs>(
+            std::get<hwmonPathField>(*_hwmonDef));
     }
 
-    updateInventory(_functional);
+    // Functional state from the inventory snapshot taken when loading, where
+    // a sensor without an inventory entry yet starts out functional.
+    // The inventory is updated with it once all the fans have been created.
+    auto state = states.find(util::INVENTORY_PATH + _invName);
+    _functional = (state != states.end()) ? state->second : true;
 
     if (!_functional && MethodMode::count == _method)
     {
@@ -133,34 +119,43 @@ TachSensor::TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
             // object can be functional with a missing D-bus sensor.
         }
 
-        auto match = getMatchString(util::FAN_SENSOR_VALUE_INTF);
-
-        tachSignal = std::make_unique<sdbusplus::bus::match_t>(
-            _bus, match.c_str(),
-            [this](auto& msg) { this->handleTachChange(msg); });
-
-        if (_hasTarget)
+        if (_hwmon)
+        {
+            // Sysfs attributes have no change notifications, so poll them
+            _hwmonTimer = std::make_unique<TimerWheel::Timer>(
+                timers, std::bind(&TachSensor::pollHwmon, this));
+            _hwmonTimer->restart(std::chrono::milliseconds(
+                std::get<hwmonPollIntervalField>(*_hwmonDef)));
+        }
+        else
         {
-            match = getMatchString(_interface);
+            auto match = getMatchString(util::FAN_SENSOR_VALUE_INTF);
 
-            targetSignal = std::make_unique<sdbusplus::bus::match_t>(
+            tachSignal = std::make_unique<sdbusplus::bus::match_t>(
                 _bus, match.c_str(),
-                [this](auto& msg) { this->handleTargetChange(msg); });
+                [this](auto& msg) { this->handleTachChange(msg); });
+
+            if (_hasTarget)
+            {
+                match = getMatchString(_interface);
+
+                targetSignal = std::make_unique<sdbusplus::bus::match_t>(
+                    _bus, match.c_str(),
+                    [this](auto& msg) { this->handleTargetChange(msg); });
+            }
         }
 
         if (_errorDelay)
         {
-            _errorTimer = std::make_unique<
-                sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
-                event, std::bind(&Fan::sensorErrorTimerExpired, &fan,
-                                 std::ref(*this)));
+            _errorTimer = std::make_unique<TimerWheel::Timer>(
+                timers, std::bind(&Fan::sensorErrorTimerExpired, &fan,
+                                  std::ref(*this)));
         }
 
         if (_method == MethodMode::count)
         {
-            _countTimer = std::make_unique<
-                sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
-                event,
+            _countTimer = std::make_unique<TimerWheel::Timer>(
+                timers,
                 std::bind(&Fan::countTimerExpired, &fan, std::ref(*this)));
         }
 #ifndef MONITOR_USE_JSON
@@ -170,6 +165,56 @@ TachSensor::TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
 
 void TachSensor::updateTachAndTarget()
 {
+    if (_hwmon)
+    {
+        _tachInput = _hwmon->read(std::get<hwmonInputField>(*_hwmonDef));
+
+        if (_hasTarget)
+        {
+            try
+            {
+                _tachTarget =
+                    _hwmon->read(std::get<hwmonTargetField>(*_hwmonDef));
+            }
+            catch (const std::exception& e)
+            {
+                log<level::ERR>(e.what());
+            }
+        }
+        return;
+    }
+
+    if (_hasTarget)
+    {
+        // The target is on another interface of the sensor object, so get
+        // the properties of all of its interfaces at once
+        try
+        {
+            auto service = util::SDBusPlus::getService(
+                _bus, _name, util::FAN_SENSOR_VALUE_INTF);
+            auto properties =
+                util::SDBusPlus::getProperties<decltype(_tachInput),
+                                               decltype(_tachTarget)>(
+                    _bus, service, _name, "");
+
+            auto input = properties.find(FAN_VALUE_PROPERTY);
+            auto target = properties.find(FAN_TARGET_PROPERTY);
+            if ((input != properties.end()) && (target != properties.end()) &&
+                std::holds_alternative<decltype(_tachInput)>(input->second) &&
+                std::holds_alternative<decltype(_tachTarget)>(target->second))
+            {
+                _tachInput = std::get<decltype(_tachInput)>(input->second);
+                _tachTarget = std::get<decltype(_tachTarget)>(target->second);
+                return;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // Fall back to reading the properties one at a time, whether
+            // the lookup or the GetAll of all interfaces failed
+        }
+    }
+
     _tachInput = util::SDBusPlus::getProperty<decltype(_tachInput)>(
         _bus, _name, util::FAN_SENSOR_VALUE_INTF, FAN_VALUE_PROPERTY);
 
@@ -179,6 +224,50 @@ void TachSensor::updateTachAndTarget()
     }
 }
 
+void TachSensor::pollHwmon()
+{
+    // The input is still checked when the target fails to be read
+    if (_hasTarget)
+    {
+        try
+        {
+            auto target = _hwmon->read(std::get<hwmonTargetField>(*_hwmonDef));
+            if (target != _tachTarget)
+            {
+                _tachTarget = target;
+
+                // Check all tach sensors on the fan against the target
+                _fan.tachChanged();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log<level::DEBUG>(
+                fmt::format("Unable to poll tach sensor {} target: {}", _name,
+                            e.what())
+                    .c_str());
+        }
+    }
+
+    try
+    {
+        double input = _hwmon->read(std::get<hwmonInputField>(*_hwmonDef));
+        if (input != _tachInput)
+        {
+            _tachInput = input;
+
+            // Check just this sensor against the target
+            _fan.tachChanged(*this);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log<level::DEBUG>(
+            fmt::format("Unable to poll tach sensor {}: {}", _name, e.what())
+                .c_str());
+    }
+}
+
 std::string TachSensor::getMatchString(const std::string& interface)
 {
     return sdbusplus::bus::match::rules::propertiesChanged(_name, interface);
@@ -373,18 +462,7 @@ void TachSensor::stopCountTimer()
 
 void TachSensor::updateInventory(bool functional)
 {
-    auto objectMap =
-        util::getObjMap<bool>(_invName, util::OPERATIONAL_STATUS_INTF,
-                              util::FUNCTIONAL_PROPERTY, functional);
-
-    auto response = util::SDBusPlus::callMethod(
-        _bus, util::INVENTORY_SVC, util::INVENTORY_PATH, util::INVENTORY_INTF,
-        "Notify", objectMap);
-
-    if (response.is_method_error())
-    {
-        log<level::ERR>("Error in notify update of tach sensor inventory");
-    }
+    _fan.getInventoryNotifier().update(_invName, functional);
 }
 
 } // namespace monitor
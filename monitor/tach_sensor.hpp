@@ -1,5 +1,9 @@
 #pragma once
 
+#include "hwmon_sysfs.hpp"
+#include "sdbusplus.hpp"
+#include "timer_wheel.hpp"
+
 #include <fmt/format.h>
 
 #include <phosphor-logging/log.hpp>
@@ -7,10 +11,13 @@
 #include <sdbusplus/bus/match.hpp>
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/event.hpp>
-#include <sdeventplus/utility/timer.hpp>
 
 #include <chrono>
+#include <map>
+#include <memory>
 #include <optional>
+#include <string>
+#include <tuple>
 #include <utility>
 
 namespace phosphor
@@ -57,6 +64,29 @@ enum MethodMode
     count
 };
 
+constexpr auto hwmonPathField = 0;
+constexpr auto hwmonInputField = 1;
+constexpr auto hwmonTargetField = 2;
+constexpr auto hwmonPollIntervalField = 3;
+
+/**
+ * Configuration of reading a tach sensor directly from hwmon sysfs
+ * Tuple constructed of:
+ *     std::string = The hwmon directory, or a device's directory containing it
+ *     std::string = The tach input attribute, i.e. fan1_input
+ *     std::string = The target attribute, i.e. fan1_target or pwm1, or empty
+ *                   when the sensor has no target
+ *     size_t = Interval in milliseconds to poll the attributes at
+ */
+using HwmonDefinition =
+    std::tuple<std::string, std::string, std::string, size_t>;
+
+/**
+ * Functional states of the inventory objects that have the OperationalStatus
+ * interface, keyed by their full inventory object path
+ */
+using FunctionalStates = std::map<std::string, bool>;
+
 /**
  * @class TachSensor
  *
@@ -68,6 +98,10 @@ enum MethodMode
  *
  * This class has a parent Fan object that knows about all
  * sensors for that fan.
+ *
+ * The tach input and target are normally tracked through the sensor's D-Bus
+ * properties, but can instead be polled directly from the attributes of the
+ * fan controller's hwmon sysfs directory when configured to.
  */
 class TachSensor
 {
@@ -101,15 +135,21 @@ class TachSensor
      * @param[in] errorDelay - Delay in seconds before creating an error
      *                         or std::nullopt if no errors.
      * @param[in] countInterval - In count mode interval
+     * @param[in] hwmon - Hwmon sysfs attributes to read in place of D-Bus
+     *                    or std::nullopt to use D-Bus.
+     * @param[in] states - Inventory functional states snapshot to get the
+     *                     sensor's initial functional state from
      *
-     * @param[in] event - Event loop reference
+     * @param[in] timers - Timer wheel to run the sensor's timers on
      */
     TachSensor(Mode mode, sdbusplus::bus::bus& bus, Fan& fan,
                const std::string& id, bool hasTarget, size_t funcDelay,
                const std::string& interface, double factor, int64_t offset,
                size_t method, size_t threshold, bool ignoreAboveMax,
                size_t timeout, const std::optional<size_t>& errorDelay,
-               size_t countInterval, const sdeventplus::Event& event);
+               size_t countInterval,
+               const std::optional<HwmonDefinition>& hwmon,
+               const FunctionalStates& states, TimerWheel& timers);
 
     /**
      * @brief Reads a property from the input message and stores it in value.
@@ -128,17 +168,11 @@ class TachSensor
                                         const std::string& propertyName,
                                         T& value)
     {
-        std::string sensor;
-        std::map<std::string, std::variant<T>> data;
-        msg.read(sensor, data);
-
-        if (sensor.compare(interface) == 0)
+        auto changed = util::SDBusPlus::getChangedProperty<T>(msg, interface,
+                                                              propertyName);
+        if (changed)
         {
-            auto propertyMap = data.find(propertyName);
-            if (propertyMap != data.end())
-            {
-                value = std::get<T>(propertyMap->second);
-            }
+            value = *changed;
         }
     }
 
@@ -320,6 +354,14 @@ class TachSensor
         return _name;
     };
 
+    /**
+     * Returns the sensor's inventory path relative to the inventory root
+     */
+    inline const std::string& getInvName() const
+    {
+        return _invName;
+    }
+
     /**
      * @brief Says if the error timer is running
      *
@@ -356,7 +398,7 @@ class TachSensor
 
     /**
      * @brief Refreshes the tach input and target values by
-     *        reading them from D-Bus.
+     *        reading them from D-Bus, or hwmon sysfs when configured.
      */
     void updateTachAndTarget();
 
@@ -384,8 +426,14 @@ class TachSensor
     void handleTachChange(sdbusplus::message::message& msg);
 
     /**
-     * @brief Updates the Functional property in the inventory
-     *        for this tach sensor based on the value passed in.
+     * @brief Reads the tach input and target from hwmon sysfs, calling
+     *        Fan::tachChanged() for any that changed.
+     */
+    void pollHwmon();
+
+    /**
+     * @brief Queues an update of the Functional property in the
+     *        inventory for this tach sensor based on the value passed in.
      *
      * @param[in] functional - If the Functional property should
      *                         be set to true or false.
@@ -494,7 +542,7 @@ class TachSensor
     /**
      * The timer object
      */
-    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer;
+    TimerWheel::Timer _timer;
 
     /**
      * @brief The match object for the Value properties changed signal
@@ -520,9 +568,7 @@ class TachSensor
      *
      * If _errorDelay is std::nullopt, then this won't be created.
      */
-    std::unique_ptr<
-        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
-        _errorTimer;
+    std::unique_ptr<TimerWheel::Timer> _errorTimer;
 
     /**
      * @brief The interval, in seconds, to use for the timer that runs
@@ -534,9 +580,24 @@ class TachSensor
      * @brief The timer used by the 'count' method for determining
      *        functional status.
      */
-    std::unique_ptr<
-        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
-        _countTimer;
+    std::unique_ptr<TimerWheel::Timer> _countTimer;
+
+    /**
+     * @brief The hwmon sysfs attributes read in place of D-Bus
+     *
+     * If std::nullopt, the sensor's D-Bus properties are used.
+     */
+    const std::optional<HwmonDefinition> _hwmonDef;
+
+    /**
+     * @brief The hwmon sysfs directory of the attributes
+     */
+    std::unique_ptr<util::HwmonSysfs> _hwmon;
+
+    /**
+     * @brief The timer to poll the hwmon sysfs attributes with
+     */
+    std::unique_ptr<TimerWheel::Timer> _hwmonTimer;
 };
 
 } // namespace monitor
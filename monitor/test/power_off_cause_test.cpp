@@ -53,3 +53,39 @@ TEST(PowerOffCauseTest, NonfuncRotorTest)
     health["fan2"] = {false, {true, true}};
     EXPECT_FALSE(cause.satisfied(health));
 }
+
+TEST(PowerOffCauseTest, FanHealthCountsTest)
+{
+    FanHealth health{{"fan0", {true, {true, true}}},
+                     {"fan1", {true, {true, true}}}};
+    EXPECT_EQ(health.missingFans(), 0u);
+    EXPECT_EQ(health.nonfuncRotors(), 0u);
+
+    health["fan0"] = {false, {false, true}};
+    EXPECT_EQ(health.missingFans(), 1u);
+    EXPECT_EQ(health.nonfuncRotors(), 1u);
+
+    // Replacing an entry removes its previous counts
+    health["fan0"] = {false, {false, false}};
+    health["fan2"] = {true, {false}};
+    EXPECT_EQ(health.missingFans(), 1u);
+    EXPECT_EQ(health.nonfuncRotors(), 3u);
+
+    health.setPendingErrors("fan0", 2);
+    health.setPendingErrors("fan2", 1);
+    EXPECT_EQ(health.pendingErrorRotors(), 3u);
+
+    health.setPendingErrors("fan0", 1);
+    EXPECT_EQ(health.pendingErrorRotors(), 2u);
+
+    health["fan0"] = {true, {true, true}};
+    health.setPendingErrors("fan0", 0);
+    EXPECT_EQ(health.missingFans(), 0u);
+    EXPECT_EQ(health.nonfuncRotors(), 1u);
+    EXPECT_EQ(health.pendingErrorRotors(), 1u);
+
+    health.clear();
+    EXPECT_EQ(health.size(), 0u);
+    EXPECT_EQ(health.nonfuncRotors(), 0u);
+    EXPECT_EQ(health.pendingErrorRotors(), 0u);
+}
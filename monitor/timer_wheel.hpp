@@ -0,0 +1,333 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace phosphor::fan::monitor
+{
+
+/**
+ * @class TimerWheel
+ *
+ * Runs all of the fan and tach sensor timers of fan monitor from a single
+ * sd-event time source instead of each timer having its own.
+ *
+ * Timer expirations are rounded up to the next tick of the wheel, and the
+ * timers are kept in slots ordered by tick. The one underlying sd-event
+ * timer is only armed for the next tick with a timer in it, so there are no
+ * idle wakeups, and all timers within the same tick are expired in one
+ * batch. This coalesces the periodic count timers of all the sensors using
+ * the same count interval into a single wakeup.
+ */
+class TimerWheel
+{
+  public:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+    using Duration = std::chrono::microseconds;
+    using TimePoint = Clock::time_point;
+
+    /* The length of a tick, which timer expirations are rounded up to */
+    static constexpr Duration resolution = std::chrono::milliseconds(50);
+
+    /**
+     * @class Timer
+     *
+     * A timer run by the wheel that has the same semantics as an
+     * sdeventplus::utility::Timer, either expiring once or periodically.
+     */
+    class Timer
+    {
+      public:
+        using Callback = std::function<void()>;
+
+        Timer() = delete;
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        // Not moveable since the wheel refers to the timer by address
+        Timer(Timer&&) = delete;
+        Timer& operator=(Timer&&) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * The timer starts out disabled.
+         *
+         * @param[in] wheel - The timer wheel to run the timer on
+         * @param[in] callback - Function to call when the timer expires
+         */
+        Timer(TimerWheel& wheel, Callback&& callback) :
+            _wheel(wheel), _callback(std::move(callback))
+        {}
+
+        ~Timer()
+        {
+            _wheel.cancel(*this);
+        }
+
+        /**
+         * @brief Returns if the timer is enabled
+         */
+        inline bool isEnabled() const
+        {
+            return _slot.has_value();
+        }
+
+        /**
+         * @brief Enables or disables the timer
+         *
+         * Enabling a disabled timer restarts it with its last interval.
+         *
+         * @param[in] enabled - If the timer should be enabled
+         */
+        void setEnabled(bool enabled)
+        {
+            if (!enabled)
+            {
+                _wheel.cancel(*this);
+            }
+            else if (!isEnabled() && _interval)
+            {
+                _wheel.schedule(*this, _wheel.now() + *_interval);
+            }
+        }
+
+        /**
+         * @brief Restarts the timer to expire periodically
+         *
+         * @param[in] interval - The period of the timer
+         */
+        void restart(Duration interval)
+        {
+            _interval = interval;
+            _periodic = true;
+            _wheel.schedule(*this, _wheel.now() + interval);
+        }
+
+        /**
+         * @brief Restarts the timer to expire once
+         *
+         * @param[in] timeout - The time until the timer expires
+         */
+        void restartOnce(Duration timeout)
+        {
+            _interval = timeout;
+            _periodic = false;
+            _wheel.schedule(*this, _wheel.now() + timeout);
+        }
+
+      private:
+        friend class TimerWheel;
+
+        /* The wheel the timer is run on */
+        TimerWheel& _wheel;
+
+        /* Function called on expiration */
+        Callback _callback;
+
+        /* The last interval or timeout given */
+        std::optional<Duration> _interval;
+
+        /* If the timer restarts itself on expiration */
+        bool _periodic = false;
+
+        /* The exact time the timer expires at */
+        TimePoint _expiration;
+
+        /* The wheel's slot for the timer while enabled */
+        std::optional<std::multimap<uint64_t, Timer*>::iterator> _slot;
+    };
+
+    TimerWheel() = delete;
+    ~TimerWheel() = default;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] event - The event loop to run the timers on
+     */
+    explicit TimerWheel(const sdeventplus::Event& event) :
+        _event(event), _source(event, std::bind(&TimerWheel::expire, this))
+    {}
+
+    /**
+     * @brief Returns the number of enabled timers
+     */
+    inline size_t size() const
+    {
+        return _slots.size();
+    }
+
+    /**
+     * @brief Returns the number of times the wheel has woken up to
+     *        expire timers
+     */
+    inline uint64_t getWakeups() const
+    {
+        return _wakeups;
+    }
+
+  private:
+    /**
+     * @brief Returns the event loop's current time
+     */
+    TimePoint now() const
+    {
+        return Clock(_event).now();
+    }
+
+    /**
+     * @brief Returns the tick a time falls within
+     */
+    static uint64_t tickOf(TimePoint time)
+    {
+        return time.time_since_epoch() / resolution;
+    }
+
+    /**
+     * @brief Puts a timer in the slot of the tick at or after its
+     *        expiration, which is always a later tick than the current one
+     *
+     * @param[in] timer - The timer
+     * @param[in] expiration - The time the timer expires at
+     */
+    void schedule(Timer& timer, TimePoint expiration)
+    {
+        removeSlot(timer);
+
+        auto tick = tickOf(expiration);
+        if (tick * resolution < expiration.time_since_epoch())
+        {
+            tick++;
+        }
+        tick = std::max(tick, tickOf(now()) + 1);
+
+        timer._expiration = expiration;
+        timer._slot = _slots.emplace(tick, &timer);
+        arm();
+    }
+
+    /**
+     * @brief Disables a timer
+     *
+     * @param[in] timer - The timer
+     */
+    void cancel(Timer& timer)
+    {
+        if (timer.isEnabled())
+        {
+            removeSlot(timer);
+            arm();
+        }
+    }
+
+    /**
+     * @brief Takes a timer out of its slot
+     *
+     * @param[in] timer - The timer
+     */
+    void removeSlot(Timer& timer)
+    {
+        if (timer._slot)
+        {
+            _slots.erase(*timer._slot);
+            timer._slot.reset();
+        }
+    }
+
+    /**
+     * @brief Arms the underlying sd-event timer for the first tick with a
+     *        timer in it, or disables it when there are no timers
+     */
+    void arm()
+    {
+        if (_expiring)
+        {
+            // Armed once all the expired timers have been run
+            return;
+        }
+
+        if (_slots.empty())
+        {
+            _armedTick.reset();
+            if (_source.isEnabled())
+            {
+                _source.setEnabled(false);
+            }
+            return;
+        }
+
+        auto tick = _slots.begin()->first;
+        if (!_armedTick || *_armedTick != tick || !_source.isEnabled())
+        {
+            auto timeout = TimePoint{tick * resolution} - now();
+            _source.restartOnce(std::max(timeout, Duration::zero()));
+            _armedTick = tick;
+        }
+    }
+
+    /**
+     * @brief Expires all the timers in the slots up to the current tick
+     *
+     * Called when the underlying sd-event timer expires.
+     */
+    void expire()
+    {
+        _wakeups++;
+        _armedTick.reset();
+        _expiring = true;
+
+        const auto current = now();
+        const auto tick = tickOf(current);
+        while (!_slots.empty() && _slots.begin()->first <= tick)
+        {
+            auto& timer = *_slots.begin()->second;
+            removeSlot(timer);
+
+            if (timer._periodic)
+            {
+                // Periodic timers don't drift, unless they fell behind
+                auto next = timer._expiration + *timer._interval;
+                schedule(timer, std::max(next, current));
+            }
+
+            // The callback may restart, stop or destroy any timer, including
+            // this one, so the timer isn't used after it
+            timer._callback();
+        }
+
+        _expiring = false;
+        arm();
+    }
+
+    /* The event loop */
+    const sdeventplus::Event& _event;
+
+    /* The underlying sd-event timer */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _source;
+
+    /* The enabled timers keyed by the tick they expire in */
+    std::multimap<uint64_t, Timer*> _slots;
+
+    /* The tick the underlying timer is armed for */
+    std::optional<uint64_t> _armedTick;
+
+    /* If expired timers are being run */
+    bool _expiring = false;
+
+    /* The number of wakeups to expire timers */
+    uint64_t _wakeups = 0;
+};
+
+} // namespace phosphor::fan::monitor
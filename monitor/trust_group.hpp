@@ -64,8 +64,10 @@ class Group
      * in the group's list of names.
      *
      * @param[in] sensor - the TachSensor to register
+     *
+     * @return bool - if the sensor was added to the group
      */
-    void registerSensor(std::shared_ptr<monitor::TachSensor>& sensor)
+    bool registerSensor(std::shared_ptr<monitor::TachSensor>& sensor)
     {
         auto found = std::find_if(
             _names.begin(), _names.end(), [&sensor](const auto& name) {
@@ -76,7 +78,9 @@ class Group
         if (found != _names.end())
         {
             _sensors.push_back({sensor, std::get<inTrust>(*found)});
+            return true;
         }
+        return false;
     }
 
     /**
@@ -91,7 +95,7 @@ class Group
     {
         return (std::find_if(_sensors.begin(), _sensors.end(),
                              [&sensor](const auto& s) {
-                                 return sensor.name() == s.sensor->name();
+                                 return s.sensor.get() == &sensor;
                              }) != _sensors.end());
     }
 
@@ -141,15 +145,30 @@ class Group
     {
         if (inGroup(sensor))
         {
-            auto trust = checkGroupTrust();
-
-            setTrust(trust);
-
-            return std::tuple<bool, bool>(_trusted, _stateChange);
+            return updateTrust();
         }
         return std::tuple<bool, bool>(true, false);
     }
 
+    /**
+     * Determines the trust for this group after one of its
+     * sensors' status changed, for callers that already know
+     * the sensor is in the group.
+     *
+     * @return tuple<bool, bool> -
+     *   field 0 - the trust value
+     *   field 1 - if that trust value changed since last call
+     *             to checkTrust
+     */
+    std::tuple<bool, bool> updateTrust()
+    {
+        auto trust = checkGroupTrust();
+
+        setTrust(trust);
+
+        return std::tuple<bool, bool>(_trusted, _stateChange);
+    }
+
     /**
      * Says if all sensors in the group are currently trusted,
      * as determined by the last call to checkTrust().
@@ -5,6 +5,7 @@
 #include "types.hpp"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace phosphor
@@ -85,28 +86,31 @@ class Manager
     {
         auto trusted = true;
 
-        for (auto& group : groups)
+        auto sensorGroups = _sensorGroups.find(&sensor);
+        if (sensorGroups == _sensorGroups.end())
+        {
+            return trusted;
+        }
+
+        for (auto* group : sensorGroups->second)
         {
-            if (group->inGroup(sensor))
+            bool trust, changed;
+            std::tie(trust, changed) = group->updateTrust();
+
+            if (!trust)
             {
-                bool trust, changed;
-                std::tie(trust, changed) = group->checkTrust(sensor);
+                trusted = false;
 
-                if (!trust)
+                if (changed)
                 {
-                    trusted = false;
-
-                    if (changed)
-                    {
-                        group->cancelMonitoring();
-                    }
+                    group->cancelMonitoring();
                 }
-                else
+            }
+            else
+            {
+                if (changed)
                 {
-                    if (changed)
-                    {
-                        group->startMonitoring();
-                    }
+                    group->startMonitoring();
                 }
             }
         }
@@ -121,9 +125,13 @@ class Manager
      */
     void registerSensor(std::shared_ptr<monitor::TachSensor>& sensor)
     {
-        std::for_each(groups.begin(), groups.end(), [&sensor](auto& group) {
-            group->registerSensor(sensor);
-        });
+        for (auto& group : groups)
+        {
+            if (group->registerSensor(sensor))
+            {
+                _sensorGroups[sensor.get()].push_back(group.get());
+            }
+        }
     }
 
   private:
@@ -131,6 +139,13 @@ class Manager
      * The list of sensor trust groups
      */
     std::vector<std::unique_ptr<Group>> groups;
+
+    /**
+     * The trust groups each registered sensor belongs to,
+     * so checking a sensor's trust only visits its own groups
+     */
+    std::unordered_map<const monitor::TachSensor*, std::vector<Group*>>
+        _sensorGroups;
 };
 
 } // namespace trust
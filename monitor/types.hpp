@@ -7,7 +7,10 @@
 #include <phosphor-logging/log.hpp>
 #include <xyz/openbmc_project/Object/Enable/server.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <initializer_list>
+#include <map>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -109,9 +112,11 @@ constexpr auto factorField = 3;
 constexpr auto offsetField = 4;
 constexpr auto thresholdField = 5;
 constexpr auto ignoreAboveMaxField = 6;
+constexpr auto hwmonField = 7;
 
 using SensorDefinition =
-    std::tuple<std::string, bool, std::string, double, int64_t, size_t, bool>;
+    std::tuple<std::string, bool, std::string, double, int64_t, size_t, bool,
+               std::optional<HwmonDefinition>>;
 
 constexpr auto fanNameField = 0;
 constexpr auto methodField = 1;
@@ -136,7 +141,178 @@ constexpr auto presentHealthPos = 0;
 constexpr auto sensorFuncHealthPos = 1;
 
 using FanHealthEntry = std::tuple<bool, std::vector<bool>>;
-using FanHealth = std::map<std::string, FanHealthEntry>;
+
+/**
+ * @class FanHealth
+ *
+ * The presence and rotor functional states of each fan, keyed by fan name,
+ * along with running totals of missing fans, nonfunctional rotors and
+ * rotors with pending error timers. The totals are adjusted as each fan's
+ * entry is replaced so they can be read without scanning every fan.
+ */
+class FanHealth
+{
+  public:
+    using value_type = std::pair<const std::string, FanHealthEntry>;
+
+    /**
+     * @class EntryRef
+     *
+     * Reference to a fan's entry that keeps the totals up to date when the
+     * entry is assigned to.
+     */
+    class EntryRef
+    {
+      public:
+        EntryRef(FanHealth& health, const std::string& name) :
+            _health(health), _name(name)
+        {}
+
+        EntryRef& operator=(const FanHealthEntry& entry)
+        {
+            _health.set(_name, entry);
+            return *this;
+        }
+
+      private:
+        FanHealth& _health;
+        const std::string _name;
+    };
+
+    FanHealth() = default;
+
+    FanHealth(std::initializer_list<value_type> entries)
+    {
+        for (const auto& [name, entry] : entries)
+        {
+            set(name, entry);
+        }
+    }
+
+    EntryRef operator[](const std::string& name)
+    {
+        return EntryRef{*this, name};
+    }
+
+    auto begin() const
+    {
+        return _entries.begin();
+    }
+
+    auto end() const
+    {
+        return _entries.end();
+    }
+
+    auto find(const std::string& name) const
+    {
+        return _entries.find(name);
+    }
+
+    size_t size() const
+    {
+        return _entries.size();
+    }
+
+    /**
+     * @brief Replaces a fan's entry and adjusts the totals by the difference
+     *
+     * @param[in] name - The fan name
+     * @param[in] entry - The fan's presence and rotor functional states
+     */
+    void set(const std::string& name, const FanHealthEntry& entry)
+    {
+        auto it = _entries.find(name);
+        if (it != _entries.end())
+        {
+            count(it->second, false);
+            it->second = entry;
+        }
+        else
+        {
+            it = _entries.emplace(name, entry).first;
+        }
+        count(it->second, true);
+    }
+
+    /**
+     * @brief Sets the number of a fan's rotors with a pending error timer
+     *
+     * @param[in] name - The fan name
+     * @param[in] pending - The number of rotors with pending errors
+     */
+    void setPendingErrors(const std::string& name, size_t pending)
+    {
+        auto& current = _pendingErrors[name];
+        _pendingErrorRotors = _pendingErrorRotors - current + pending;
+        current = pending;
+    }
+
+    void clear()
+    {
+        _entries.clear();
+        _pendingErrors.clear();
+        _missingFans = 0;
+        _nonfuncRotors = 0;
+        _pendingErrorRotors = 0;
+    }
+
+    /**
+     * @brief Returns the number of fans that aren't present
+     */
+    inline size_t missingFans() const
+    {
+        return _missingFans;
+    }
+
+    /**
+     * @brief Returns the number of nonfunctional rotors across all fans
+     */
+    inline size_t nonfuncRotors() const
+    {
+        return _nonfuncRotors;
+    }
+
+    /**
+     * @brief Returns the number of rotors across all fans with an error
+     *        timer running, whose errors haven't been created yet
+     */
+    inline size_t pendingErrorRotors() const
+    {
+        return _pendingErrorRotors;
+    }
+
+  private:
+    /**
+     * @brief Adds or removes an entry's contribution to the totals
+     *
+     * @param[in] entry - The fan's entry
+     * @param[in] add - If the entry is added, otherwise it's removed
+     */
+    void count(const FanHealthEntry& entry, bool add)
+    {
+        const auto& rotors = std::get<sensorFuncHealthPos>(entry);
+        size_t missing = std::get<presentHealthPos>(entry) ? 0 : 1;
+        size_t nonfunc = std::count(rotors.begin(), rotors.end(), false);
+        if (add)
+        {
+            _missingFans += missing;
+            _nonfuncRotors += nonfunc;
+        }
+        else
+        {
+            _missingFans -= missing;
+            _nonfuncRotors -= nonfunc;
+        }
+    }
+
+    std::map<std::string, FanHealthEntry> _entries;
+    std::map<std::string, size_t> _pendingErrors;
+    size_t _missingFans = 0;
+    size_t _nonfuncRotors = 0;
+    size_t _pendingErrorRotors = 0;
+};
+
 } // namespace monitor
 } // namespace fan
 } // namespace phosphor
@@ -180,16 +180,11 @@ class PGoodState : public PowerState
      */
     void pgoodChanged(sdbusplus::message::message& msg)
     {
-        std::string interface;
-        std::map<std::string, std::variant<int32_t>> properties;
-
-        msg.read(interface, properties);
-
-        auto pgoodProp = properties.find(_pgoodProperty);
-        if (pgoodProp != properties.end())
+        auto pgood = util::SDBusPlus::getChangedProperty<int32_t>(
+            msg, _pgoodInterface, _pgoodProperty);
+        if (pgood)
         {
-            auto pgood = std::get<int32_t>(pgoodProp->second);
-            setPowerState(pgood);
+            setPowerState(*pgood);
         }
     }
 
@@ -113,32 +113,28 @@ bool Tach::present()
 
 void Tach::propertiesChanged(size_t sensor, sdbusplus::message::message& msg)
 {
-    std::string iface;
-    util::Properties<double> properties;
-    msg.read(iface, properties);
-
-    propertiesChanged(sensor, properties);
+    // Find the Value property containing the speed.
+    auto speed = util::SDBusPlus::getChangedProperty<double>(msg, tachIface,
+                                                             tachProperty);
+    if (speed)
+    {
+        tachChanged(sensor, *speed);
+    }
 }
 
-void Tach::propertiesChanged(size_t sensor,
-                             const util::Properties<double>& props)
+void Tach::tachChanged(size_t sensor, double speed)
 {
-    // Find the Value property containing the speed.
-    auto it = props.find(tachProperty);
-    if (it != props.end())
-    {
-        auto& s = state[sensor];
-        std::get<double>(s) = std::get<double>(it->second);
+    auto& s = state[sensor];
+    std::get<double>(s) = speed;
 
-        auto newState =
-            std::any_of(state.begin(), state.end(),
-                        [](const auto& s) { return std::get<double>(s) != 0; });
+    auto newState =
+        std::any_of(state.begin(), state.end(),
+                    [](const auto& s) { return std::get<double>(s) != 0; });
 
-        if (currentState != newState)
-        {
-            getPolicy().stateChanged(newState, *this);
-            currentState = newState;
-        }
+    if (currentState != newState)
+    {
+        getPolicy().stateChanged(newState, *this);
+        currentState = newState;
     }
 }
 
@@ -85,14 +85,12 @@ class Tach : public PresenceSensor
     virtual RedundancyPolicy& getPolicy() = 0;
 
     /**
-     * @brief Properties changed handler for tach sensor updates.
+     * @brief Handler for tach sensor speed updates.
      *
      * @param[in] sensor - The sensor that changed.
-     * @param[in] props - The properties that changed.
+     * @param[in] speed - The sensor's new speed.
      */
-    void
-        propertiesChanged(size_t sensor,
-                          const phosphor::fan::util::Properties<double>& props);
+    void tachChanged(size_t sensor, double speed);
 
     /**
      * @brief Properties changed handler for tach sensor updates.
@@ -20,6 +20,8 @@
 #else
 #include "generated.hpp"
 #endif
+#include "sdbusplus.hpp"
+
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
@@ -33,6 +35,7 @@ int main(void)
     auto bus = sdbusplus::bus::new_default();
     auto event = sdeventplus::Event::get_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+    util::SDBusPlus::enableServiceCache(bus);
 
 #ifdef PRESENCE_USE_JSON
 
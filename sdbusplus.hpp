@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <systemd/sd-bus.h>
 
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/elog.hpp>
@@ -10,6 +11,16 @@
 #include <sdbusplus/message.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace phosphor
 {
 namespace fan
@@ -19,6 +30,62 @@ namespace util
 namespace detail
 {
 namespace errors = sdbusplus::xyz::openbmc_project::Common::Error;
+
+/**
+ * @brief The D-Bus type code of a basic type, and the type sd-bus reads
+ *        it into.
+ */
+template <typename T>
+struct BasicType;
+
+template <>
+struct BasicType<bool>
+{
+    static constexpr char code = SD_BUS_TYPE_BOOLEAN;
+    using ReadType = int;
+};
+
+template <>
+struct BasicType<int32_t>
+{
+    static constexpr char code = SD_BUS_TYPE_INT32;
+    using ReadType = int32_t;
+};
+
+template <>
+struct BasicType<uint32_t>
+{
+    static constexpr char code = SD_BUS_TYPE_UINT32;
+    using ReadType = uint32_t;
+};
+
+template <>
+struct BasicType<int64_t>
+{
+    static constexpr char code = SD_BUS_TYPE_INT64;
+    using ReadType = int64_t;
+};
+
+template <>
+struct BasicType<uint64_t>
+{
+    static constexpr char code = SD_BUS_TYPE_UINT64;
+    using ReadType = uint64_t;
+};
+
+template <>
+struct BasicType<double>
+{
+    static constexpr char code = SD_BUS_TYPE_DOUBLE;
+    using ReadType = double;
+};
+
+template <>
+struct BasicType<std::string>
+{
+    static constexpr char code = SD_BUS_TYPE_STRING;
+    using ReadType = const char*;
+};
 } // namespace detail
 
 /**
@@ -100,6 +167,294 @@ class DBusPropertyError : public DBusError
     const std::string property;
 };
 
+/**
+ * @brief Decode the object path and interface names of an InterfacesAdded
+ *        signal
+ *
+ * The properties in the signal are skipped over instead of being decoded,
+ * for handling the signals of every object on the bus cheaply.
+ *
+ * @param[in] msg - The InterfacesAdded signal message
+ * @param[in] handler - Called with the path and each interface added
+ *
+ * @throws DBusError when the signal fails to be decoded
+ */
+template <typename Handler>
+void readInterfacesAdded(sdbusplus::message::message& msg, Handler&& handler)
+{
+    auto* m = msg.get();
+    const char* path = nullptr;
+    auto r = sd_bus_message_read_basic(m, SD_BUS_TYPE_OBJECT_PATH, &path);
+    if (r >= 0)
+    {
+        r = sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sa{sv}}");
+    }
+
+    while (r >= 0)
+    {
+        r = sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                           "sa{sv}");
+        if (r <= 0)
+        {
+            break;
+        }
+
+        const char* interface = nullptr;
+        r = sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &interface);
+        if (r >= 0)
+        {
+            handler(std::string_view{path}, std::string_view{interface});
+            r = sd_bus_message_skip(m, "a{sv}");
+        }
+        if (r >= 0)
+        {
+            r = sd_bus_message_exit_container(m);
+        }
+    }
+
+    if (r >= 0)
+    {
+        r = sd_bus_message_exit_container(m);
+    }
+    if (r < 0)
+    {
+        throw DBusError{fmt::format(
+            "Failed to decode InterfacesAdded signal: {}", std::strerror(-r))};
+    }
+}
+
+/**
+ * @brief Match rule for the mapper's signal that it finished introspecting
+ *        a service started after the mapper, whose name is the argument
+ *
+ * Lookups only find a new service's objects from then on, not from when
+ * the service's name gets its owner.
+ */
+inline std::string introspectionComplete()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    return rules::type::signal() +
+           rules::path("/xyz/openbmc_project/object_mapper") +
+           rules::interface("xyz.openbmc_project.ObjectMapper.Private") +
+           rules::member("IntrospectionComplete");
+}
+
+/**
+ * @class ServiceCache
+ *
+ * Caches the services the mapper returned for object paths and interfaces,
+ * including lookups that failed, so that reading a property doesn't need
+ * a GetObject call to the mapper every time.
+ *
+ * The cache watches the bus to invalidate its entries:
+ *  - InterfacesAdded and InterfacesRemoved drop the entries of the path's
+ *    interfaces.
+ *  - NameOwnerChanged for a well-known name losing its owner drops the
+ *    entries with that service.
+ *  - The mapper's IntrospectionComplete for a new service drops all of the
+ *    failed lookups since the new service may provide them. Doing so when
+ *    the service's name gets its owner would be too early, as lookups fail
+ *    until the mapper has introspected the service.
+ *  - NameOwnerChanged for the mapper itself drops everything.
+ *
+ * Services that don't emit InterfacesAdded may need their failed lookups
+ * invalidated explicitly.
+ */
+class ServiceCache
+{
+  public:
+    ServiceCache() = delete;
+    ~ServiceCache() = default;
+    ServiceCache(const ServiceCache&) = delete;
+    ServiceCache& operator=(const ServiceCache&) = delete;
+    ServiceCache(ServiceCache&&) = delete;
+    ServiceCache& operator=(ServiceCache&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] bus - The bus to cache the lookups made on
+     */
+    explicit ServiceCache(sdbusplus::bus::bus& bus) :
+        _bus(bus.get()),
+        _addedMatch(bus, sdbusplus::bus::match::rules::interfacesAdded(),
+                    [this](auto& msg) { interfacesAdded(msg); }),
+        _removedMatch(bus, sdbusplus::bus::match::rules::interfacesRemoved(),
+                      [this](auto& msg) { interfacesRemoved(msg); }),
+        _ownerMatch(bus, sdbusplus::bus::match::rules::nameOwnerChanged(),
+                    [this](auto& msg) { nameOwnerChanged(msg); }),
+        _introspectedMatch(bus, introspectionComplete(),
+                           [this](auto&) { introspected(); })
+    {}
+
+    /**
+     * @brief Returns if the cache is for the bus passed in
+     */
+    inline bool isFor(sdbusplus::bus::bus& bus) const
+    {
+        return bus.get() == _bus;
+    }
+
+    /**
+     * @brief Look up the service of a path and interface
+     *
+     * @param[in] path - The object path
+     * @param[in] interface - The interface
+     *
+     * @return A pointer to the service, which is empty when the mapper
+     *         didn't find one, or nullptr when not cached
+     */
+    const std::string* find(const std::string& path,
+                            const std::string& interface) const
+    {
+        auto it = _services.find(std::make_pair(path, interface));
+        return (it != _services.end()) ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Cache the service of a path and interface
+     *
+     * @param[in] path - The object path
+     * @param[in] interface - The interface
+     * @param[in] service - The service, or empty when the lookup failed
+     */
+    void insert(const std::string& path, const std::string& interface,
+                const std::string& service)
+    {
+        _services[std::make_pair(path, interface)] = service;
+    }
+
+    /**
+     * @brief Drop the cached service of a path and interface
+     *
+     * @param[in] path - The object path
+     * @param[in] interface - The interface
+     */
+    void invalidate(const std::string& path, const std::string& interface)
+    {
+        _services.erase(std::make_pair(path, interface));
+    }
+
+    /**
+     * @brief Drop everything cached
+     */
+    void clear()
+    {
+        _services.clear();
+    }
+
+  private:
+    /**
+     * @brief Drop the entries of a path's interfaces that were added
+     *
+     * @param[in] msg - The InterfacesAdded signal
+     */
+    void interfacesAdded(sdbusplus::message::message& msg)
+    {
+        try
+        {
+            readInterfacesAdded(msg, [this](auto path, auto interface) {
+                invalidate(std::string{path}, std::string{interface});
+            });
+        }
+        catch (const DBusError&)
+        {
+            // Nothing to invalidate from a malformed signal
+        }
+    }
+
+    /**
+     * @brief Drop the entries of a path's interfaces that were removed
+     *
+     * @param[in] msg - The InterfacesRemoved signal
+     */
+    void interfacesRemoved(sdbusplus::message::message& msg)
+    {
+        sdbusplus::message::object_path path;
+        std::vector<std::string> interfaces;
+        msg.read(path, interfaces);
+
+        for (const auto& interface : interfaces)
+        {
+            invalidate(path.str, interface);
+        }
+    }
+
+    /**
+     * @brief Drop the entries a change of a name's owner affects
+     *
+     * @param[in] msg - The NameOwnerChanged signal
+     */
+    void nameOwnerChanged(sdbusplus::message::message& msg)
+    {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        msg.read(name, oldOwner, newOwner);
+
+        if (name == "xyz.openbmc_project.ObjectMapper")
+        {
+            clear();
+            return;
+        }
+
+        // The mapper only returns well-known names, and the unique names of
+        // short lived connections, like each busctl call, come and go often
+        if (oldOwner.empty() || name.empty() || (name.front() == ':'))
+        {
+            return;
+        }
+
+        for (auto it = _services.begin(); it != _services.end();)
+        {
+            if (it->second == name)
+            {
+                it = _services.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * @brief Drop the failed lookups once the mapper knows a new service
+     */
+    void introspected()
+    {
+        for (auto it = _services.begin(); it != _services.end();)
+        {
+            if (it->second.empty())
+            {
+                it = _services.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /* The bus the lookups are cached for */
+    sd_bus* _bus;
+
+    /* The services keyed by path and interface, empty when not found */
+    std::map<std::pair<std::string, std::string>, std::string> _services;
+
+    /* Match for InterfacesAdded signals */
+    sdbusplus::bus::match::match _addedMatch;
+
+    /* Match for InterfacesRemoved signals */
+    sdbusplus::bus::match::match _removedMatch;
+
+    /* Match for NameOwnerChanged signals */
+    sdbusplus::bus::match::match _ownerMatch;
+
+    /* Match for the mapper's IntrospectionComplete signals */
+    sdbusplus::bus::match::match _introspectedMatch;
+};
+
 /** @brief Alias for PropertiesChanged signal callbacks. */
 template <typename... T>
 using Properties = std::map<std::string, std::variant<T...>>;
@@ -289,9 +644,23 @@ class SDBusPlus
     }
 
     /** @brief Get service from the mapper. */
-    static auto getService(sdbusplus::bus::bus& bus, const std::string& path,
-                           const std::string& interface)
+    static std::string getService(sdbusplus::bus::bus& bus,
+                                  const std::string& path,
+                                  const std::string& interface)
     {
+        auto* cache = getServiceCache(bus);
+        if (cache)
+        {
+            if (const auto* service = cache->find(path, interface); service)
+            {
+                if (service->empty())
+                {
+                    throw DBusServiceError{path, interface};
+                }
+                return *service;
+            }
+        }
+
         try
         {
             auto mapperResp = getServiceRaw(bus, path, interface);
@@ -304,14 +673,56 @@ class SDBusPlus
                     "Empty mapper response on service lookup");
                 throw DBusServiceError{path, interface};
             }
+            if (cache)
+            {
+                cache->insert(path, interface, mapperResp.begin()->first);
+            }
             return mapperResp.begin()->first;
         }
         catch (const DBusMethodError& e)
         {
+            if (cache)
+            {
+                cache->insert(path, interface, std::string{});
+            }
             throw DBusServiceError{path, interface};
         }
     }
 
+    /**
+     * @brief Cache the mapper's service lookups made on a bus
+     *
+     * Once enabled, getService() and all of the calls using it only go to
+     * the mapper for lookups that aren't cached yet. The bus must be
+     * processed by an event loop for the cache to see the signals that
+     * invalidate it.
+     *
+     * @param[in] bus - The bus to cache the lookups of
+     */
+    static void enableServiceCache(sdbusplus::bus::bus& bus)
+    {
+        serviceCache() = std::make_unique<ServiceCache>(bus);
+    }
+
+    /**
+     * @brief Drop the cached service of a path and interface, so that the
+     *        next lookup of it goes to the mapper
+     *
+     * For when a lookup that failed is known to succeed now but a signal
+     * to invalidate it wasn't emitted.
+     *
+     * @param[in] path - The object path
+     * @param[in] interface - The interface
+     */
+    static void invalidateService(const std::string& path,
+                                  const std::string& interface)
+    {
+        if (serviceCache())
+        {
+            serviceCache()->invalidate(path, interface);
+        }
+    }
+
     /** @brief Get service from the mapper. */
     static auto getService(const std::string& path,
                            const std::string& interface)
@@ -467,6 +878,88 @@ class SDBusPlus
                                            property);
     }
 
+    /**
+     * @brief Get all of an interface's properties with one GetAll call,
+     *        with mapper lookup.
+     *
+     * @tparam Types - The types of the properties wanted. Properties of
+     *                 other types are in the map default constructed.
+     * @param[in] bus - The bus
+     * @param[in] path - The object path
+     * @param[in] interface - The interface
+     *
+     * @return A map of the property names to their values
+     */
+    template <typename... Types>
+    static auto getProperties(sdbusplus::bus::bus& bus,
+                              const std::string& path,
+                              const std::string& interface)
+    {
+        auto service = getService(bus, path, interface);
+        return getProperties<Types...>(bus, service, path, interface);
+    }
+
+    /** @brief Get all of an interface's properties with mapper lookup. */
+    template <typename... Types>
+    static auto getProperties(const std::string& path,
+                              const std::string& interface)
+    {
+        return getProperties<Types...>(getBus(), path, interface);
+    }
+
+    /**
+     * @brief Get all of an interface's properties with one GetAll call,
+     *        without mapper lookup.
+     *
+     * An empty interface gets the properties of all of the object's
+     * interfaces from services implemented with sd-bus, for reading
+     * properties of different interfaces of an object in one call.
+     *
+     * @tparam Types - The types of the properties wanted. Properties of
+     *                 other types are in the map default constructed.
+     * @param[in] bus - The bus
+     * @param[in] service - The service
+     * @param[in] path - The object path
+     * @param[in] interface - The interface, or empty for all of them
+     *
+     * @return A map of the property names to their values
+     *
+     * @throws DBusPropertyError when the call fails or is rejected, such as
+     *         by a service not supporting a GetAll of all interfaces
+     */
+    template <typename... Types>
+    static auto getProperties(sdbusplus::bus::bus& bus,
+                              const std::string& service,
+                              const std::string& path,
+                              const std::string& interface)
+    {
+        using namespace std::literals::string_literals;
+
+        try
+        {
+            auto msg = callMethodAndReturn(bus, service, path,
+                                           "org.freedesktop.DBus.Properties"s,
+                                           "GetAll"s, interface);
+            Properties<Types...> properties;
+            msg.read(properties);
+            return properties;
+        }
+        catch (const sdbusplus::exception::exception&)
+        {
+            throw DBusPropertyError{"DBus get all properties failed", service,
+                                    path, interface, ""};
+        }
+    }
+
+    /** @brief Get all of an interface's properties without mapper lookup. */
+    template <typename... Types>
+    static auto getProperties(const std::string& service,
+                              const std::string& path,
+                              const std::string& interface)
+    {
+        return getProperties<Types...>(getBus(), service, path, interface);
+    }
+
     /** @brief Set a property with mapper lookup. */
     template <typename Property>
     static void setProperty(sdbusplus::bus::bus& bus, const std::string& path,
@@ -589,6 +1082,141 @@ class SDBusPlus
 
         return respMsg;
     }
+
+    /**
+     * @brief Decode a PropertiesChanged signal, only reading the values of
+     *        the changed properties that are wanted.
+     *
+     * The interface and property names are used in place within the
+     * message, and the values of unwanted properties, or of properties not
+     * of type T, are skipped over without being decoded. Nothing is
+     * allocated to decode the signal.
+     *
+     * @tparam T - The basic D-Bus type of the wanted properties' values
+     * @param[in] msg - The PropertiesChanged signal message
+     * @param[in] wanted - Called with the interface and each changed
+     *                     property's name, returns if its value is wanted
+     * @param[in] handler - Called with each wanted property's name and value
+     *
+     * @throws DBusError when the signal fails to be decoded
+     */
+    template <typename T, typename Wanted, typename Handler>
+    static void readPropertiesChanged(sdbusplus::message::message& msg,
+                                      Wanted&& wanted, Handler&& handler)
+    {
+        using Basic = detail::BasicType<T>;
+        static constexpr char signature[] = {Basic::code, '\0'};
+
+        auto* m = msg.get();
+        const char* interface = nullptr;
+        auto r = sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &interface);
+        if (r >= 0)
+        {
+            r = sd_bus_message_enter_container(m, SD_BUS_TYPE_ARRAY, "{sv}");
+        }
+
+        while (r >= 0)
+        {
+            r = sd_bus_message_enter_container(m, SD_BUS_TYPE_DICT_ENTRY,
+                                               "sv");
+            if (r <= 0)
+            {
+                break;
+            }
+
+            const char* name = nullptr;
+            const char* contents = nullptr;
+            r = sd_bus_message_read_basic(m, SD_BUS_TYPE_STRING, &name);
+            if ((r >= 0) && wanted(std::string_view{interface},
+                                   std::string_view{name}))
+            {
+                r = sd_bus_message_peek_type(m, nullptr, &contents);
+            }
+
+            if ((r >= 0) && (contents != nullptr) &&
+                (std::strcmp(contents, signature) == 0))
+            {
+                typename Basic::ReadType value{};
+                r = sd_bus_message_enter_container(m, SD_BUS_TYPE_VARIANT,
+                                                   signature);
+                if (r >= 0)
+                {
+                    r = sd_bus_message_read_basic(m, Basic::code, &value);
+                }
+                if (r >= 0)
+                {
+                    r = sd_bus_message_exit_container(m);
+                }
+                if (r >= 0)
+                {
+                    handler(std::string_view{name}, static_cast<T>(value));
+                }
+            }
+            else if (r >= 0)
+            {
+                r = sd_bus_message_skip(m, "v");
+            }
+
+            if (r >= 0)
+            {
+                r = sd_bus_message_exit_container(m);
+            }
+        }
+
+        if (r >= 0)
+        {
+            r = sd_bus_message_exit_container(m);
+        }
+        if (r < 0)
+        {
+            throw DBusError{
+                fmt::format("Failed to decode PropertiesChanged signal: {}",
+                            std::strerror(-r))};
+        }
+    }
+
+    /**
+     * @brief Get the new value of a single property from a
+     *        PropertiesChanged signal.
+     *
+     * @param[in] msg - The PropertiesChanged signal message
+     * @param[in] interface - The property's interface
+     * @param[in] property - The property name
+     *
+     * @return The property's value, or std::nullopt if the signal isn't
+     *         for the interface or the property didn't change
+     *
+     * @throws DBusError when the signal fails to be decoded
+     */
+    template <typename T>
+    static std::optional<T> getChangedProperty(sdbusplus::message::message& msg,
+                                               std::string_view interface,
+                                               std::string_view property)
+    {
+        std::optional<T> value;
+        readPropertiesChanged<T>(
+            msg,
+            [interface, property](auto intf, auto prop) {
+                return (intf == interface) && (prop == property);
+            },
+            [&value](auto, T v) { value = std::move(v); });
+        return value;
+    }
+
+  private:
+    /** @brief The process wide service cache, when enabled. */
+    static std::unique_ptr<ServiceCache>& serviceCache()
+    {
+        static std::unique_ptr<ServiceCache> cache;
+        return cache;
+    }
+
+    /** @brief Get the service cache for a bus, if enabled for it. */
+    static ServiceCache* getServiceCache(sdbusplus::bus::bus& bus)
+    {
+        auto& cache = serviceCache();
+        return (cache && cache->isFor(bus)) ? cache.get() : nullptr;
+    }
 };
 
 } // namespace util
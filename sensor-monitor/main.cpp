@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "power_state.hpp"
+#include "sdbusplus.hpp"
 #include "shutdown_alarm_monitor.hpp"
 #include "threshold_alarm_logger.hpp"
 
@@ -27,6 +28,7 @@ int main(int argc, char* argv[])
     auto event = sdeventplus::Event::get_default();
     auto bus = sdbusplus::bus::new_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+    phosphor::fan::util::SDBusPlus::enableServiceCache(bus);
 
 #ifdef ENABLE_HOST_STATE
     std::shared_ptr<phosphor::fan::PowerState> powerState =
@@ -17,6 +17,8 @@
 
 #include "shutdown_alarm_monitor.hpp"
 
+#include "sdbusplus.hpp"
+
 #include <fmt/format.h>
 #include <unistd.h>
 
@@ -170,17 +172,44 @@ void ShutdownAlarmMonitor::checkAlarms()
 void ShutdownAlarmMonitor::propertiesChanged(
     sdbusplus::message::message& message)
 {
-    std::map<std::string, std::variant<bool>> properties;
-    std::string interface;
-
     if (!_powerState->isPowerOn())
     {
         return;
     }
 
-    message.read(interface, properties);
+    std::optional<ShutdownType> type;
+    std::optional<bool> lowAlarm;
+    std::optional<bool> highAlarm;
+
+    // Only the alarm properties of the shutdown interfaces are decoded
+    SDBusPlus::readPropertiesChanged<bool>(
+        message,
+        [this, &type](std::string_view interface,
+                      std::string_view propertyName) {
+            if (!type)
+            {
+                type = getShutdownType(interface);
+                if (!type)
+                {
+                    return false;
+                }
+            }
+            const auto& names = alarmProperties.at(*type);
+            return (propertyName == names.at(AlarmType::low)) ||
+                   (propertyName == names.at(AlarmType::high));
+        },
+        [&type, &lowAlarm, &highAlarm](std::string_view propertyName,
+                                       bool value) {
+            if (propertyName == alarmProperties.at(*type).at(AlarmType::low))
+            {
+                lowAlarm = value;
+            }
+            else
+            {
+                highAlarm = value;
+            }
+        });
 
-    auto type = getShutdownType(interface);
     if (!type)
     {
         return;
@@ -188,8 +217,7 @@ void ShutdownAlarmMonitor::propertiesChanged(
 
     std::string sensorPath = message.get_path();
 
-    const auto& lowAlarmName = alarmProperties.at(*type).at(AlarmType::low);
-    if (properties.count(lowAlarmName) > 0)
+    if (lowAlarm)
     {
         AlarmKey alarmKey{sensorPath, *type, AlarmType::low};
         auto alarm = alarms.find(alarmKey);
@@ -197,11 +225,10 @@ void ShutdownAlarmMonitor::propertiesChanged(
         {
             alarms.emplace(alarmKey, nullptr);
         }
-        checkAlarm(std::get<bool>(properties.at(lowAlarmName)), alarmKey);
+        checkAlarm(*lowAlarm, alarmKey);
     }
 
-    const auto& highAlarmName = alarmProperties.at(*type).at(AlarmType::high);
-    if (properties.count(highAlarmName) > 0)
+    if (highAlarm)
     {
         AlarmKey alarmKey{sensorPath, *type, AlarmType::high};
         auto alarm = alarms.find(alarmKey);
@@ -209,7 +236,7 @@ void ShutdownAlarmMonitor::propertiesChanged(
         {
             alarms.emplace(alarmKey, nullptr);
         }
-        checkAlarm(std::get<bool>(properties.at(highAlarmName)), alarmKey);
+        checkAlarm(*highAlarm, alarmKey);
     }
 }
 
@@ -446,7 +473,7 @@ void ShutdownAlarmMonitor::createEventLog(
 }
 
 std::optional<ShutdownType>
-    ShutdownAlarmMonitor::getShutdownType(const std::string& interface) const
+    ShutdownAlarmMonitor::getShutdownType(std::string_view interface) const
 {
     auto it = std::find_if(
         shutdownInterfaces.begin(), shutdownInterfaces.end(),
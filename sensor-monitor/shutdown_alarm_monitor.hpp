@@ -26,6 +26,7 @@
 
 #include <chrono>
 #include <optional>
+#include <string_view>
 
 namespace sensor::monitor
 {
@@ -146,7 +147,7 @@ class ShutdownAlarmMonitor
      *         of the shutdown interfaces.
      */
     std::optional<ShutdownType>
-        getShutdownType(const std::string& interface) const;
+        getShutdownType(std::string_view interface) const;
 
     /**
      * @brief Creates a phosphor-logging event log
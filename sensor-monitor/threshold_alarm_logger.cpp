@@ -49,7 +49,9 @@ using ErrorData = std::tuple<ErrorName, Entry::Level>;
 /**
  * Map of threshold interfaces and alarm properties and values to error data.
  */
-const std::map<InterfaceName, std::map<PropertyName, std::map<bool, ErrorData>>>
+const std::map<InterfaceName,
+               std::map<PropertyName, std::map<bool, ErrorData>, std::less<>>,
+               std::less<>>
     thresholdData{
 
         {warningInterface,
@@ -137,23 +139,33 @@ ThresholdAlarmLogger::ThresholdAlarmLogger(
 
 void ThresholdAlarmLogger::propertiesChanged(sdbusplus::message::message& msg)
 {
-    std::map<std::string, std::variant<bool>> properties;
     std::string sensorPath = msg.get_path();
+    const std::map<PropertyName, std::map<bool, ErrorData>, std::less<>>*
+        alarmProperties = nullptr;
     std::string interface;
 
-    msg.read(interface, properties);
-
-    auto alarmProperties = thresholdData.find(interface);
-    if (alarmProperties == thresholdData.end())
-    {
-        return;
-    }
+    // Only the alarm properties of the threshold interfaces are decoded
+    SDBusPlus::readPropertiesChanged<bool>(
+        msg,
+        [&alarmProperties, &interface](std::string_view intf,
+                                       std::string_view propertyName) {
+            if (!alarmProperties)
+            {
+                auto it = thresholdData.find(intf);
+                if (it == thresholdData.end())
+                {
+                    return false;
+                }
+                alarmProperties = &it->second;
+                interface = it->first;
+            }
+            return alarmProperties->find(propertyName) !=
+                   alarmProperties->end();
+        },
+        [this, &sensorPath, &interface](std::string_view name,
+                                        bool alarmValue) {
+            std::string propertyName{name};
 
-    for (const auto& [propertyName, propertyValue] : properties)
-    {
-        if (alarmProperties->second.find(propertyName) !=
-            alarmProperties->second.end())
-        {
             // If this is the first time we've seen this alarm, then
             // assume it was off before so it doesn't create an event
             // log for a value of false.
@@ -165,7 +177,6 @@ void ThresholdAlarmLogger::propertiesChanged(sdbusplus::message::message& msg)
             }
 
             // Check if the value changed from what was there before.
-            auto alarmValue = std::get<bool>(propertyValue);
             if (alarmValue != alarms[key][propertyName])
             {
                 alarms[key][propertyName] = alarmValue;
@@ -176,8 +187,7 @@ void ThresholdAlarmLogger::propertiesChanged(sdbusplus::message::message& msg)
                                    alarmValue);
                 }
             }
-        }
-    }
+        });
 }
 
 void ThresholdAlarmLogger::interfacesRemoved(sdbusplus::message::message& msg)
@@ -209,27 +219,38 @@ void ThresholdAlarmLogger::checkThresholds(const std::string& interface,
         return;
     }
 
+    Properties<bool, double> values;
+    try
+    {
+        values = SDBusPlus::getProperties<bool, double>(bus, service,
+                                                        sensorPath, interface);
+    }
+    catch (const DBusError& e)
+    {
+        // The sensor may have gone away since it was found, skip it
+        return;
+    }
+
     for (const auto& [property, unused] : properties->second)
     {
-        try
+        // Sensor daemons that get their direction from entity manager
+        // may only be putting either the high alarm or low alarm on
+        // D-Bus, not both.
+        auto value = values.find(property);
+        if ((value == values.end()) ||
+            !std::holds_alternative<bool>(value->second))
         {
-            auto alarmValue = SDBusPlus::getProperty<bool>(
-                bus, service, sensorPath, interface, property);
-            alarms[InterfaceKey(sensorPath, interface)][property] = alarmValue;
-
-            // This is just for checking alarms on startup,
-            // so only look for active alarms.
-            if (alarmValue && _powerState->isPowerOn())
-            {
-                createEventLog(sensorPath, interface, property, alarmValue);
-            }
+            continue;
         }
-        catch (const sdbusplus::exception::exception& e)
+
+        auto alarmValue = std::get<bool>(value->second);
+        alarms[InterfaceKey(sensorPath, interface)][property] = alarmValue;
+
+        // This is just for checking alarms on startup,
+        // so only look for active alarms.
+        if (alarmValue && _powerState->isPowerOn())
         {
-            // Sensor daemons that get their direction from entity manager
-            // may only be putting either the high alarm or low alarm on
-            // D-Bus, not both.
-            continue;
+            createEventLog(sensorPath, interface, property, alarmValue);
         }
     }
 }
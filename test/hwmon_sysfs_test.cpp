@@ -0,0 +1,93 @@
+#include "hwmon_sysfs.hpp"
+
+#include <stdlib.h>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::fan::util;
+namespace fs = std::filesystem;
+
+class HwmonSysfsTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char dir[] = "/tmp/hwmonsysfsXXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+        root = dir;
+
+        // Fake device hwmon directory containing a single hwmonN directory
+        fs::create_directories(root / "hwmon" / "hwmon3");
+        writeFile(root / "hwmon" / "hwmon3" / "name", "max31785");
+        writeFile(root / "hwmon" / "hwmon3" / "fan1_input", "10450\n");
+        writeFile(root / "hwmon" / "hwmon3" / "fan1_target", "11000\n");
+        writeFile(root / "hwmon" / "hwmon3" / "pwm1", "255\n");
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(root);
+    }
+
+    static void writeFile(const fs::path& path, const std::string& contents)
+    {
+        std::ofstream file{path};
+        file << contents;
+    }
+
+    fs::path root;
+};
+
+TEST_F(HwmonSysfsTest, ReadWriteDirect)
+{
+    HwmonSysfs hwmon{root / "hwmon" / "hwmon3"};
+
+    EXPECT_EQ(hwmon.read("fan1_input"), 10450);
+    EXPECT_EQ(hwmon.read("pwm1"), 255);
+
+    hwmon.write("fan1_target", 9000);
+    EXPECT_EQ(hwmon.read("fan1_target"), 9000);
+
+    // Writing a shorter value must not leave any of the previous one
+    hwmon.write("pwm1", 7);
+    EXPECT_EQ(hwmon.read("pwm1"), 7);
+}
+
+TEST_F(HwmonSysfsTest, ReadWriteDeviceDir)
+{
+    // The hwmonN directory is found within the device's hwmon directory
+    HwmonSysfs hwmon{root / "hwmon"};
+
+    EXPECT_EQ(hwmon.read("fan1_input"), 10450);
+
+    hwmon.write("pwm1", 128);
+    EXPECT_EQ(hwmon.read("pwm1"), 128);
+
+    // Rebinding the driver may give the device a different hwmonN
+    fs::rename(root / "hwmon" / "hwmon3", root / "hwmon" / "hwmon5");
+    EXPECT_EQ(hwmon.read("pwm1"), 128);
+
+    fs::rename(root / "hwmon" / "hwmon5", root / "hwmon" / "hwmon6");
+    hwmon.write("pwm1", 64);
+    EXPECT_EQ(hwmon.read("pwm1"), 64);
+}
+
+TEST_F(HwmonSysfsTest, MissingAttribute)
+{
+    HwmonSysfs hwmon{root / "hwmon"};
+
+    EXPECT_THROW(hwmon.read("fan2_input"), std::runtime_error);
+    EXPECT_THROW(hwmon.write("pwm2", 100), std::runtime_error);
+
+    // Writes must not create attributes that don't exist
+    EXPECT_FALSE(fs::exists(root / "hwmon" / "pwm2"));
+    EXPECT_FALSE(fs::exists(root / "hwmon" / "hwmon3" / "pwm2"));
+}
+
+TEST_F(HwmonSysfsTest, InvalidValue)
+{
+    writeFile(root / "hwmon" / "hwmon3" / "fan1_input", "error\n");
+
+    HwmonSysfs hwmon{root / "hwmon"};
+    EXPECT_THROW(hwmon.read("fan1_input"), std::runtime_error);
+}